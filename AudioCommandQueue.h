@@ -0,0 +1,147 @@
+// === AudioCommandQueue.h ===
+#pragma once
+#include <JuceHeader.h>
+
+struct OscMode;
+
+/**
+ * A change the message thread wants the audio thread to make. Commands are
+ * plain values; anything they point to is owned by the command until the
+ * audio thread takes it.
+ */
+struct AudioCommand
+{
+    enum Type { setModifierEnabled, setModifierOrder, swapMode, swapSnapFrequencies };
+
+    Type type = setModifierEnabled;
+    int slot = 0;
+    bool enabled = false;
+    std::array<int, 4> order {};               // setModifierOrder: slot indices, first to run first
+    OscMode* mode = nullptr;                 // swapMode: the prepared replacement
+    std::vector<float>* frequencies = nullptr; // swapSnapFrequencies: the new list
+};
+
+/**
+ * Single-producer (message thread) / single-consumer (audio thread) queue of
+ * AudioCommands. Neither side locks or allocates.
+ */
+class AudioCommandQueue
+{
+public:
+    /** Message thread. False if the queue is full, in which case the caller still owns the payload. */
+    bool push(const AudioCommand& command)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 == 0)
+            return false;
+
+        commands[(size_t) (size1 > 0 ? start1 : start2)] = command;
+        fifo.finishedWrite(1);
+        return true;
+    }
+
+    /**
+     * Audio thread. Calls apply(command) for each queued command in order,
+     * stopping early (and leaving the rest queued) if apply returns false.
+     */
+    template <typename Fn>
+    void drain(Fn&& apply)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+        int consumed = 0;
+        for (int i = 0; i < size1 + size2; ++i)
+        {
+            const int index = i < size1 ? start1 + i : start2 + (i - size1);
+            if (! apply(commands[(size_t) index]))
+                break;
+            ++consumed;
+        }
+
+        fifo.finishedRead(consumed);
+    }
+
+private:
+    static constexpr int capacity = 128;
+    juce::AbstractFifo fifo { capacity };
+    std::array<AudioCommand, capacity> commands;
+};
+
+/**
+ * Destroys objects the audio thread has let go of, on a low-priority
+ * background thread, so the audio thread never hits the allocator.
+ */
+class ReleasePool : private juce::Thread
+{
+public:
+    ReleasePool() : juce::Thread("SimpleOsc Release Pool")
+    {
+        startThread(2);
+    }
+
+    ~ReleasePool() override
+    {
+        stopThread(1000);
+        releaseAll();
+    }
+
+    /** Audio thread. Check hasSpace() first; if the pool is full the object would be leaked. */
+    template <typename T>
+    bool retire(T* object)
+    {
+        if (object == nullptr)
+            return true;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 == 0)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        items[(size_t) (size1 > 0 ? start1 : start2)] = { object, [](void* p) { delete static_cast<T*>(p); } };
+        fifo.finishedWrite(1);
+        return true;
+    }
+
+    bool hasSpace() const { return fifo.getFreeSpace() > 0; }
+
+private:
+    struct Item
+    {
+        void* object = nullptr;
+        void (*destroy)(void*) = nullptr;
+    };
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            releaseAll();
+            wait(50);
+        }
+    }
+
+    void releaseAll()
+    {
+        int start1, size1, start2, size2;
+        const int numReady = fifo.getNumReady();
+        fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+        for (int i = 0; i < size1 + size2; ++i)
+        {
+            auto& item = items[(size_t) (i < size1 ? start1 + i : start2 + (i - size1))];
+            item.destroy(item.object);
+            item = {};
+        }
+
+        fifo.finishedRead(size1 + size2);
+    }
+
+    static constexpr int capacity = 256;
+    juce::AbstractFifo fifo { capacity };
+    std::array<Item, capacity> items;
+};
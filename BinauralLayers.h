@@ -0,0 +1,129 @@
+// === BinauralLayers.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "BlockSmoother.h"
+#include "PhaseAccumulator.h"
+#include "EngineParameters.h"
+
+/**
+ * Extra binaural beats stacked on the main one, e.g. a delta and a theta beat
+ * together. Each layer has its own carrier, offset, width and level; layer 1 is
+ * the mode's carrier, so these are numbered from 2 (binauralLayer2Carrier, ...).
+ *
+ * Every ear of every layer is a lane of one oscillator bank. A lane is a complex
+ * rotator (a cos/sin pair turned by a fixed rotation each sample), so the sample
+ * loop is the same few multiply-adds across all lanes, with no table lookups or
+ * branches, and vectorises. Rotators drift slowly, so each chunk re-anchors them on
+ * integer PhaseAccumulators; those are what keep the beats exact over a session.
+ */
+class BinauralLayers
+{
+public:
+    static constexpr int numLayers = EngineParameters::numBinauralLayers; // four beats in all, with the main one
+    static constexpr int firstLayerNumber = 2;
+    static constexpr int chunkSize = 256;
+
+    // Parameter defaults: every layer starts at level 0 (off)
+    static constexpr float defaultCarrier = 200.0f;
+    static constexpr std::array<float, numLayers> defaultOffsets { 2.5f, 6.0f, 10.0f }; // delta, theta, alpha
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        for (auto& l : levels) l.reset(sampleRate, 0.05);
+        for (auto& w : widths) w.reset(sampleRate, 0.05);
+    }
+
+    /** False once every layer has faded to level 0 and is staying there. */
+    bool isActive() const
+    {
+        for (auto& l : levels)
+            if (!l.isSettled() || l.getTargetValue() != 0.0f)
+                return true;
+        return false;
+    }
+
+    /** Adds the next n (up to chunkSize) samples of every layer to the two ears. */
+    void addTo(float* left, float* right, int n)
+    {
+        // Anchor each rotator on its accumulator, then move the accumulator to the chunk's end
+        alignas(16) float re[numLanes], im[numLanes], stepRe[numLanes], stepIm[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto increment = PhaseAccumulator::incrementFor(laneFrequency(lane), sampleRate);
+            const double start = PhaseAccumulator::toRadians(phases[lane].phase);
+            const double step = PhaseAccumulator::toRadians(increment);
+            re[lane] = (float) std::cos(start);
+            im[lane] = (float) std::sin(start);
+            stepRe[lane] = (float) std::cos(step);
+            stepIm[lane] = (float) std::sin(step);
+            phases[lane].phase += increment * (juce::uint32) n;
+        }
+
+        // Each layer is a 2x2 mix of its two ears, l = a * ownEar + b * otherEar with
+        // a = g(1 + w)/2, b = g(1 - w)/2: mid/side width and level in one. Ramped across the chunk.
+        alignas(16) float a[numLayers], b[numLayers], da[numLayers], db[numLayers];
+        for (int k = 0; k < numLayers; ++k)
+        {
+            const float g0 = levels[k].getCurrentValue(), w0 = widths[k].getCurrentValue();
+            levels[k].skip(n);
+            widths[k].skip(n);
+            const float g1 = levels[k].getCurrentValue(), w1 = widths[k].getCurrentValue();
+
+            a[k] = 0.5f * g0 * (1.0f + w0);
+            b[k] = 0.5f * g0 * (1.0f - w0);
+            da[k] = (0.5f * g1 * (1.0f + w1) - a[k]) / (float) n;
+            db[k] = (0.5f * g1 * (1.0f - w1) - b[k]) / (float) n;
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const float r = re[lane] * stepRe[lane] - im[lane] * stepIm[lane];
+                im[lane] = re[lane] * stepIm[lane] + im[lane] * stepRe[lane];
+                re[lane] = r;
+            }
+
+            float l = 0.0f, r = 0.0f;
+            for (int k = 0; k < numLayers; ++k)
+            {
+                a[k] += da[k];
+                b[k] += db[k];
+                l += a[k] * im[2 * k] + b[k] * im[2 * k + 1];
+                r += b[k] * im[2 * k] + a[k] * im[2 * k + 1];
+            }
+
+            left[i] += l;
+            right[i] += r;
+        }
+    }
+
+    void setParameters(const EngineParameters& params)
+    {
+        for (int k = 0; k < numLayers; ++k)
+        {
+            const auto& layer = params.binauralLayers[(size_t) k];
+            carriers[k] = layer.carrier;
+            offsets[k] = layer.offset;
+            widths[k].setTargetValue(layer.width * 2.0f - 1.0f); // 0..1 -> -1..+1, as for the main layer
+            levels[k].setTargetValue(layer.level);
+        }
+    }
+
+private:
+    static constexpr int numLanes = numLayers * 2; // lane 2k = layer k's left ear, 2k + 1 its right
+
+    float laneFrequency(int lane) const
+    {
+        const int k = lane / 2;
+        return (lane & 1) ? carriers[k] + offsets[k] : carriers[k];
+    }
+
+    double sampleRate = 44100.0;
+    std::array<float, numLayers> carriers { defaultCarrier, defaultCarrier, defaultCarrier };
+    std::array<float, numLayers> offsets = defaultOffsets;
+    std::array<BlockSmoother, numLayers> levels;
+    std::array<BlockSmoother, numLayers> widths { BlockSmoother(1.0f), BlockSmoother(1.0f), BlockSmoother(1.0f) };
+    std::array<PhaseAccumulator, numLanes> phases {};
+};
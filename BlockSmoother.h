@@ -0,0 +1,131 @@
+// === BlockSmoother.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Linear smoother for gain-like parameters that works a block at a time.
+ *
+ * Instead of a getNextValue() call per sample, fill() writes the next n
+ * values of the ramp into an array the caller multiplies with. Once the
+ * ramp has arrived, fill() returns false and leaves the array alone, and
+ * the caller applies getTargetValue() as a constant (or skips the stage
+ * when that's 0 or 1).
+ */
+class BlockSmoother
+{
+public:
+    explicit BlockSmoother(float initialValue = 0.0f) : current(initialValue), target(initialValue) {}
+
+    void reset(double newSampleRate, double rampSeconds)
+    {
+        sampleRate = newSampleRate;
+        setRampTime(rampSeconds);
+        setCurrentAndTargetValue(target);
+    }
+
+    /** Takes effect from the next setTargetValue(). */
+    void setRampTime(double rampSeconds) { rampLength = juce::jmax(0, (int) std::round(rampSeconds * sampleRate)); }
+
+    void setTargetValue(float newTarget)
+    {
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        remaining = rampLength;
+        if (remaining == 0)
+            current = target;
+        else
+            step = (target - current) / (float) remaining;
+    }
+
+    void setCurrentAndTargetValue(float value)
+    {
+        current = target = value;
+        remaining = 0;
+    }
+
+    bool isSettled() const { return remaining == 0; }
+    float getCurrentValue() const { return current; }
+    float getTargetValue() const { return target; }
+
+    /** Writes the next n values and advances. Returns false, writing nothing, when already settled. */
+    bool fill(float* dest, int n)
+    {
+        if (remaining == 0)
+            return false;
+
+        const int ramping = juce::jmin(n, remaining);
+        for (int i = 0; i < ramping; ++i)
+            dest[i] = current + step * (float) (i + 1);
+
+        remaining -= ramping;
+        current = remaining == 0 ? target : current + step * (float) ramping;
+
+        if (n > ramping)
+            juce::FloatVectorOperations::fill(dest + ramping, target, n - ramping);
+        return true;
+    }
+
+    /** Advances n samples without writing anything, for stages that are skipping a chunk. */
+    void skip(int n)
+    {
+        if (remaining == 0)
+            return;
+
+        const int ramping = juce::jmin(n, remaining);
+        remaining -= ramping;
+        current = remaining == 0 ? target : current + step * (float) ramping;
+    }
+
+    /** Multiplies n samples in place by the ramp, or by the settled value. */
+    void applyGain(float* data, int n)
+    {
+        if (remaining == 0)
+        {
+            if (target != 1.0f)
+                juce::FloatVectorOperations::multiply(data, target, n);
+            return;
+        }
+
+        const int ramping = juce::jmin(n, remaining);
+        for (int i = 0; i < ramping; ++i)
+            data[i] *= current + step * (float) (i + 1);
+
+        remaining -= ramping;
+        current = remaining == 0 ? target : current + step * (float) ramping;
+
+        if (n > ramping && target != 1.0f)
+            juce::FloatVectorOperations::multiply(data + ramping, target, n - ramping);
+    }
+
+    /** Same ramp on every channel of the buffer. */
+    void applyGain(juce::AudioBuffer<float>& buffer, int startSample, int n)
+    {
+        if (remaining == 0)
+        {
+            if (target != 1.0f)
+                buffer.applyGain(startSample, n, target);
+            return;
+        }
+
+        const float start = current;
+        const int ramping = juce::jmin(n, remaining);
+        const float end = current + step * (float) ramping;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.applyGainRamp(ch, startSample, ramping, start, end);
+
+        remaining -= ramping;
+        current = remaining == 0 ? target : end;
+
+        if (n > ramping && target != 1.0f)
+            buffer.applyGain(startSample + ramping, n - ramping, target);
+    }
+
+private:
+    double sampleRate = 44100.0;
+    int rampLength = 0;
+    int remaining = 0;
+    float current = 0.0f, target = 0.0f, step = 0.0f;
+};
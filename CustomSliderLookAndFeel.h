@@ -3,6 +3,23 @@
 #pragma once
 #include <JuceHeader.h>
 #include "FreeSlider.h"
+#include "PaintCache.h"
+
+// One colour per harmonic (index 0 = harmonic 2), shared by the level faders and the spectrum markers
+inline juce::Colour getHarmonicColor(int index)
+{
+    static const std::array<juce::Colour, 8> colors = {
+        juce::Colours::red,
+        juce::Colours::orange,
+        juce::Colours::yellow,
+        juce::Colours::green,
+        juce::Colours::blue,
+        juce::Colours::indigo,
+        juce::Colours::violet,
+        juce::Colours::pink
+    };
+    return colors[(size_t) index % colors.size()];
+}
 
 class CenteredSliderLookAndFeel : public juce::LookAndFeel_V4 {
 public:
@@ -104,10 +121,21 @@ public:
 
     void paint(juce::Graphics& g) override
     {
-        // Base background
         auto area = getLocalBounds().toFloat();
-        g.setColour(baseColour.withAlpha(0.2f));
-        g.fillRoundedRectangle(area, 4.0f);
+
+        // Base background (and the dimmed overlay when off) only depends on
+        // size, colour and toggle state, so it's blitted from a cached layer
+        juce::int64 state = ((juce::int64) baseColour.getARGB() << 1) | (isOn ? 1 : 0);
+        backgroundLayer.draw(g, getLocalBounds(), state, [this, area](juce::Graphics& lg) {
+            lg.setColour(baseColour.withAlpha(0.2f));
+            lg.fillRoundedRectangle(area, 4.0f);
+
+            if (!isOn)
+            {
+                lg.setColour(juce::Colours::black.withAlpha(0.4f));
+                lg.fillRoundedRectangle(area, 4.0f);
+            }
+        });
 
         // Fill area if on
         if (isOn)
@@ -120,11 +148,12 @@ public:
             g.setColour(baseColour.withAlpha(0.9f));
             g.fillRoundedRectangle(fillArea, 4.0f);
         }
-        else
-        {
-            g.setColour(juce::Colours::black.withAlpha(0.4f));
-            g.fillRoundedRectangle(area, 4.0f);
-        }
+    }
+
+    void resized() override
+    {
+        juce::Slider::resized();
+        backgroundLayer.invalidate();
     }
 
     void setBaseColour(juce::Colour c) { baseColour = c; repaint(); }
@@ -135,5 +164,6 @@ private:
     bool isOn = false;
     juce::Colour baseColour;
     std::function<void(int, bool)> toggleCallback;
+    CachedLayer backgroundLayer;
 };
 
@@ -0,0 +1,90 @@
+// === EngineParameters.cpp ===
+#include "EngineParameters.h"
+
+namespace
+{
+    std::atomic<float>* lookUp(juce::AudioProcessorValueTreeState& state, const juce::String& id)
+    {
+        auto* value = state.getRawParameterValue(id);
+        jassert(value != nullptr); // every field needs a parameter in createParameterLayout()
+        return value;
+    }
+}
+
+EngineParameters::Source::Source(juce::AudioProcessorValueTreeState& state)
+{
+    freeFrequency = lookUp(state, "freeFrequency");
+    glideTime = lookUp(state, "glideTime");
+    glideCurve = lookUp(state, "glideCurve");
+
+    rangeMin = lookUp(state, "rangeMin");
+    rangeMax = lookUp(state, "rangeMax");
+    sweepTime = lookUp(state, "sweepTime");
+    sweepCurve = lookUp(state, "sweepCurve");
+    sweepSource = lookUp(state, "sweepSource");
+
+    binauralOffset = lookUp(state, "binauralOffset");
+    binauralWidth = lookUp(state, "binauralWidth");
+    for (int k = 0; k < numBinauralLayers; ++k)
+    {
+        const juce::String id = "binauralLayer" + juce::String(k + 2);
+        binauralLayers[(size_t) k] = { lookUp(state, id + "Carrier"), lookUp(state, id + "Offset"),
+                                       lookUp(state, id + "Width"), lookUp(state, id + "Level") };
+    }
+
+    breathRate = lookUp(state, "breathRate");
+    breathDepth = lookUp(state, "breathDepth");
+
+    for (int h = 0; h < numHarmonics; ++h)
+    {
+        const juce::String id = "harmonic" + juce::String(h + 2);
+        harmonicOn[(size_t) h] = lookUp(state, id);
+        harmonicLevel[(size_t) h] = lookUp(state, id + "Level");
+    }
+    harmonicEngine = lookUp(state, "harmonicEngine");
+    harmonicCount = lookUp(state, "harmonicCount");
+    spectralTilt = lookUp(state, "spectralTilt");
+    spectralOddEven = lookUp(state, "spectralOddEven");
+    spectralFormantFrequency = lookUp(state, "spectralFormantFrequency");
+    spectralFormantGain = lookUp(state, "spectralFormantGain");
+
+    atmoType = lookUp(state, "atmoType");
+    atmoLevel = lookUp(state, "atmoLevel");
+}
+
+void EngineParameters::Source::read(EngineParameters& dest) const
+{
+    dest.freeFrequency = freeFrequency->load();
+    dest.glideTime = glideTime->load();
+    dest.exponentialGlide = glideCurve->load() > 0.5f;
+
+    dest.rangeMin = rangeMin->load();
+    dest.rangeMax = rangeMax->load();
+    dest.sweepTime = sweepTime->load();
+    dest.exponentialSweep = sweepCurve->load() > 0.5f;
+    dest.sweepThroughPack = sweepSource->load() > 0.5f;
+
+    dest.binauralOffset = binauralOffset->load();
+    dest.binauralWidth = binauralWidth->load();
+    for (size_t k = 0; k < binauralLayers.size(); ++k)
+        dest.binauralLayers[k] = { binauralLayers[k][0]->load(), binauralLayers[k][1]->load(),
+                                   binauralLayers[k][2]->load(), binauralLayers[k][3]->load() };
+
+    dest.breathRate = breathRate->load();
+    dest.breathDepth = breathDepth->load();
+
+    for (size_t h = 0; h < harmonicOn.size(); ++h)
+    {
+        dest.harmonicOn[h] = harmonicOn[h]->load() > 0.5f;
+        dest.harmonicLevel[h] = harmonicLevel[h]->load();
+    }
+    dest.harmonicEngine = juce::roundToInt(harmonicEngine->load());
+    dest.harmonicCount = juce::roundToInt(harmonicCount->load());
+    dest.spectralTilt = spectralTilt->load();
+    dest.spectralOddEven = spectralOddEven->load();
+    dest.spectralFormantFrequency = spectralFormantFrequency->load();
+    dest.spectralFormantGain = spectralFormantGain->load();
+
+    dest.atmoType = juce::roundToInt(atmoType->load());
+    dest.atmoLevel = atmoLevel->load();
+}
@@ -0,0 +1,77 @@
+// === EngineParameters.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Every parameter the modes and modifiers read, as plain values.
+ *
+ * The audio thread fills one from the APVTS at the start of each block (through
+ * a Source) and hands it down with setParameters(), so the engine objects are
+ * only ever touched by the audio thread and never see parameter IDs. Receivers
+ * compare with what they last applied, so an unchanged value costs nothing.
+ */
+struct EngineParameters
+{
+    static constexpr int numBinauralLayers = 3;
+    static constexpr int numHarmonics = 8; // harmonics 2..9
+
+    // Modes
+    float freeFrequency = 0.0f;
+    float glideTime = 0.05f;
+    bool exponentialGlide = false;
+    float rangeMin = 0.0f, rangeMax = 2222.0f;
+    float sweepTime = 30.0f;
+    bool exponentialSweep = true;
+    bool sweepThroughPack = false;
+
+    // Binaural; widths are the 0..1 parameter values
+    struct BinauralLayer
+    {
+        float carrier = 200.0f, offset = 0.0f, width = 1.0f, level = 0.0f;
+    };
+
+    float binauralOffset = 0.0f;
+    float binauralWidth = 1.0f;
+    std::array<BinauralLayer, numBinauralLayers> binauralLayers {};
+
+    // Breath
+    float breathRate = 0.25f, breathDepth = 0.5f;
+
+    // Harmonics, index 0 = harmonic 2
+    std::array<bool, numHarmonics> harmonicOn {};
+    std::array<float, numHarmonics> harmonicLevel { 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f };
+    int harmonicEngine = 0; // index into the "harmonicEngine" choices
+    int harmonicCount = 64;
+    float spectralTilt = -6.0f, spectralOddEven = 0.0f;
+    float spectralFormantFrequency = 1000.0f, spectralFormantGain = 0.0f;
+
+    // Atmosphere
+    int atmoType = 0;
+    float atmoLevel = 0.25f;
+
+    /**
+     * The APVTS values behind an EngineParameters. IDs are looked up once, on
+     * construction, so read() is nothing but atomic loads and is safe on the
+     * audio thread.
+     */
+    class Source
+    {
+    public:
+        explicit Source(juce::AudioProcessorValueTreeState& state);
+
+        void read(EngineParameters& dest) const;
+
+    private:
+        using Value = std::atomic<float>*;
+
+        Value freeFrequency, glideTime, glideCurve;
+        Value rangeMin, rangeMax, sweepTime, sweepCurve, sweepSource;
+        Value binauralOffset, binauralWidth;
+        std::array<std::array<Value, 4>, numBinauralLayers> binauralLayers; // carrier, offset, width, level
+        Value breathRate, breathDepth;
+        std::array<Value, numHarmonics> harmonicOn, harmonicLevel;
+        Value harmonicEngine, harmonicCount;
+        Value spectralTilt, spectralOddEven, spectralFormantFrequency, spectralFormantGain;
+        Value atmoType, atmoLevel;
+    };
+};
@@ -4,21 +4,13 @@
 #include "PluginProcessor.h"
 #include "DebugUtils.h"
 
-std::vector<float> snapFrequencies = { 0.0f, 174.0f, 285.0f, 396.0f, 417.0f, 528.0f, 639.0f, 741.0f, 852.0f, 963.0f }; // Default preset list
-
 FreeMode::FreeMode(SimpleOscAudioProcessor* proc)
     : processor(proc) {}
 
 void FreeMode::prepare(double sampleRate)
 {
     currentSampleRate = sampleRate;
-    juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(512), static_cast<juce::uint32>(2) };
-    osc.prepare(spec);
-    offsetOsc.prepare(spec);
-    offsetOsc.initialise([](float x) { return std::sin(x + juce::MathConstants<float>::halfPi); });
-//    smoothedFreq.reset(sampleRate, 0.0015);
-    smoothedFreq.setCurrentAndTargetValue(frequency);
-    osc.setFrequency(frequency);
+    glide.prepare(sampleRate);
 }
 
 void FreeMode::processBlock(juce::AudioBuffer<float>& buffer,
@@ -30,92 +22,75 @@ void FreeMode::processBlock(juce::AudioBuffer<float>& buffer,
         return;
     }
 
-    const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
-    float mainFreq = smoothedFreq.getNextValue();
-    bool binauralOn = processor->modifierEngine.isModifierEnabled(0);
-    float offset = processor->modifierEngine.getOffsetHz();
-    float widthAmount = processor->modifierEngine.getStereoWidth();
+    for (int start = 0; start < buffer.getNumSamples(); start += chunkSize)
+    {
+        const int n = juce::jmin(chunkSize, buffer.getNumSamples() - start);
+        renderChunk(buffer.getWritePointer(0, start), numChannels >= 2 ? buffer.getWritePointer(1, start) : nullptr, n);
 
-    buffer.clear();
+        for (int ch = 2; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, start, buffer, 0, start, n);
+    }
+    // Binaural, breath, atmosphere and the harmonics are applied once by the processor, after the mode(s)
+}
 
-    if (binauralOn && numChannels >= 2)
+void FreeMode::renderChunk(float* carrier, float* quadrature, int n)
+{
+    // 0 Hz is "OFF"; glides never pass through it, so a whole chunk is either silent or not
+    if (glide.getCurrent() < 1.0f && glide.getTarget() < 1.0f)
     {
-        osc.setFrequency(mainFreq);
-        offsetOsc.setFrequency(mainFreq + offset);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            float left = osc.processSample(0.0f);
-            float right = offsetOsc.processSample(0.0f);
+        juce::FloatVectorOperations::clear(carrier, n);
+        if (quadrature != nullptr)
+            juce::FloatVectorOperations::clear(quadrature, n);
+        return;
+    }
 
-            float mid = 0.5f * (left + right);
-            float sideL = (left - mid) * widthAmount;
-            float sideR = (right - mid) * widthAmount;
+    glide.fillIncrements(increments.data(), n);
 
-            buffer.setSample(0, sample, mid + sideL);
-            buffer.setSample(1, sample, mid + sideR);
+    if (quadrature != nullptr)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const auto p = osc.next(increments[(size_t) i]);
+            carrier[i] = sineTable.sin(p);
+            quadrature[i] = sineTable.cos(p);
         }
-
-        // === Apply Breath (LFO) Gain Modulation AFTER Oscillator ===
-        processor->modifierEngine.process(buffer);
-        
-        // Apply harmonics centered
-        juce::AudioBuffer<float> harmonicBuffer;
-        harmonicBuffer.setSize(numChannels, numSamples);
-        harmonicBuffer.clear();
-        processor->modifierEngine.process(harmonicBuffer, mainFreq);
-        for (int ch = 0; ch < numChannels; ++ch)
-            buffer.addFrom(ch, 0, harmonicBuffer, ch, 0, numSamples);
-
-        return;
     }
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    else
     {
-        float currentFreq = smoothedFreq.getNextValue();
+        for (int i = 0; i < n; ++i)
+            carrier[i] = sineTable.sin(osc.next(increments[(size_t) i]));
+    }
 
-        if (snapOn && !snapFrequencies.empty()) {
-            currentFreq = *std::min_element(snapFrequencies.begin(), snapFrequencies.end(),
-                [currentFreq](float a, float b) {
-                    return std::abs(a - currentFreq) < std::abs(b - currentFreq);
-                });
-        }
+    mainFreq = glide.getCurrent();
+}
 
-        if (currentFreq < 1.0f)
-        {
-            for (int ch = 0; ch < numChannels; ++ch)
-                buffer.setSample(ch, sample, 0.0f);
-            continue;
-        }
+void FreeMode::setPhase(juce::uint32 newPhase)
+{
+    // Taking over from another mode: start on its phase at the target rather than gliding in
+    osc.phase = newPhase;
+    glide.jumpTo(frequency);
+}
 
-        osc.setFrequency(currentFreq);
-        float val = osc.processSample(0.0f);
-        for (int ch = 0; ch < numChannels; ++ch)
-            buffer.setSample(ch, sample, val);
-    }
-    // === Apply Breath (LFO) Gain Modulation AFTER Oscillator ===
-    processor->modifierEngine.process(buffer);
-    
-    // Apply harmonics centered
-    juce::AudioBuffer<float> harmonicBuffer;
-    harmonicBuffer.setSize(numChannels, numSamples);
-    harmonicBuffer.clear();
-    processor->modifierEngine.process(harmonicBuffer, mainFreq);
-    for (int ch = 0; ch < numChannels; ++ch)
-        buffer.addFrom(ch, 0, harmonicBuffer, ch, 0, numSamples);
+void FreeMode::setParameters(const EngineParameters& params)
+{
+    setGlideParameters(params);
+
+    // A new target starts a glide, so only when it moves
+    if (params.freeFrequency != frequency)
+        setFrequency(params.freeFrequency);
 }
 
-void FreeMode::parameterChanged(const juce::String& paramID, float newValue)
+void FreeMode::setGlideParameters(const EngineParameters& params)
 {
-    if (paramID == "freeFrequency")
-    {
-        frequency = newValue;
-            smoothedFreq.setCurrentAndTargetValue(frequency);
-    }
-    else if (paramID == "snapOn")
-    {
-        snapOn = (newValue > 0.5f);
-    }
+    // Before any new target, so a time and a frequency changed together glide at the new time
+    glide.setTime(params.glideTime);
+    glide.setCurve(params.exponentialGlide ? Glide::exponential : Glide::linear);
+}
+
+void FreeMode::setFrequency(float newFrequency)
+{
+    frequency = newFrequency;
+    glide.setTarget(frequency);
 }
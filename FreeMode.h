@@ -1,6 +1,7 @@
 // === FreeMode.h ===
 #pragma once
 #include "OscMode.h"
+#include "Glide.h"
 #include <juce_dsp/juce_dsp.h>
 
 class SimpleOscAudioProcessor; // forward declaration
@@ -13,19 +14,29 @@ public:
     void processBlock(juce::AudioBuffer<float>& buffer,
                       juce::MidiBuffer& midiMessages,
                       bool isOn) override;
-    void parameterChanged(const juce::String& paramID,
-                          float newValue) override;
+    void setParameters(const EngineParameters& params) override;
+
+    juce::uint32 getPhase() const override { return osc.phase; }
+    void setPhase(juce::uint32 newPhase) override;
+    float getFrequency() const override { return mainFreq; }
+
+    bool canRenderChunks() const override { return true; }
+    void renderChunk(float* carrier, float* quadrature, int n) override;
+
+protected:
+    void setFrequency(float newFrequency);
+    void setGlideParameters(const EngineParameters& params);
+
+    SimpleOscAudioProcessor* processor = nullptr;
 
 private:
+    static constexpr int chunkSize = 256;
+
     double currentSampleRate = 44100.0;
     float frequency = 0.0f;
-    juce::SmoothedValue<float> smoothedFreq;
-    juce::dsp::Oscillator<float> offsetOsc;
-    juce::dsp::Oscillator<float> osc{[](float x){ return std::sin(x); }};
-    bool snapOn = false;
-
-    SimpleOscAudioProcessor* processor = nullptr; // new member
+    float mainFreq = 0.0f;
+    Glide glide;
+    PhaseAccumulator osc;
+    std::array<juce::uint32, chunkSize> increments {};
 };
 
-extern std::vector<float> snapFrequencies;
-
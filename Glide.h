@@ -0,0 +1,108 @@
+// === Glide.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "PhaseAccumulator.h"
+
+/**
+ * Portamento between carrier frequencies.
+ *
+ * A new target starts a glide of glideTime seconds from wherever the current
+ * frequency is, either linear in Hz or exponential (straight in pitch). The
+ * per-sample step (an added Hz, or a ratio) is worked out once per target,
+ * and fillIncrements() turns the next n samples into PhaseAccumulator
+ * increments for the oscillator loop, so the loop itself does no glide logic.
+ *
+ * Gliding to or from 0 Hz ("OFF") jumps instead, since there's no pitch to
+ * slide from.
+ */
+class Glide
+{
+public:
+    enum Curve { linear, exponential };
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        jumpTo((float) target);
+    }
+
+    void setTime(float seconds) { glideSeconds = juce::jmax(0.0f, seconds); }
+    void setCurve(Curve newCurve) { curve = newCurve; }
+
+    void setTarget(float hz)
+    {
+        target = hz;
+        remaining = (int) std::round(glideSeconds * sampleRate);
+
+        if (remaining == 0 || current < 1.0 || target < 1.0)
+        {
+            jumpTo(hz);
+            return;
+        }
+
+        if (curve == exponential)
+        {
+            step = std::log(target / current) / remaining;
+            ratio = std::exp(step);
+        }
+        else
+        {
+            step = (target - current) / remaining;
+        }
+    }
+
+    void jumpTo(float hz)
+    {
+        current = target = hz;
+        remaining = 0;
+        step = 0.0;
+        ratio = 1.0;
+    }
+
+    float getCurrent() const { return (float) current; }
+    float getTarget() const { return (float) target; }
+
+    /** Writes the phase increment for each of the next n samples and advances the glide. */
+    void fillIncrements(juce::uint32* increments, int n)
+    {
+        const int gliding = juce::jmin(n, remaining);
+
+        if (gliding > 0)
+        {
+            if (curve == exponential)
+            {
+                // One multiply per sample; the chunk's end is re-anchored from the log step, so
+                // rounding in the recurrence never carries over
+                double f = current;
+                for (int i = 0; i < gliding; ++i)
+                {
+                    f *= ratio;
+                    increments[i] = PhaseAccumulator::incrementFor(f, sampleRate);
+                }
+                current *= std::exp(step * gliding);
+            }
+            else
+            {
+                for (int i = 0; i < gliding; ++i)
+                    increments[i] = PhaseAccumulator::incrementFor(current + step * (i + 1), sampleRate);
+                current += step * gliding;
+            }
+
+            remaining -= gliding;
+            if (remaining == 0)
+                current = target; // don't leave rounding error behind
+        }
+
+        if (n > gliding)
+            std::fill(increments + gliding, increments + n, PhaseAccumulator::incrementFor(current, sampleRate));
+    }
+
+private:
+    double sampleRate = 44100.0;
+    float glideSeconds = 0.05f;
+    Curve curve = linear;
+
+    double current = 0.0, target = 0.0, step = 0.0;
+    double ratio = 1.0; // exponential: exp(step), the per-sample frequency ratio
+    int remaining = 0;
+};
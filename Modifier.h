@@ -2,13 +2,24 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "EngineParameters.h"
+
+/** What every modifier gets per block, alongside the audio. */
+struct ModifierContext {
+    float baseFrequency = 0.0f; // the leading mode's current frequency
+    bool isOn = true;           // false once the oscillator has faded out after being switched off
+    const float* oscillatorGain = nullptr; // its on/off fade per sample while that runs, else null
+    const float* carrier = nullptr; // the lead carrier as rendered, before any modifier; null when not captured
+    bool carrierIsBlend = false;    // true while two modes crossfade, so the carrier isn't a single sine
+};
 
 class Modifier {
 public:
     virtual ~Modifier() = default;
     virtual void prepare(double sampleRate, int samplesPerBlock, int numChannels) = 0;
-    virtual void process(juce::AudioBuffer<float>& buffer) = 0;
-    virtual void parameterChanged(const juce::String& paramID, float newValue) = 0;
+    virtual void process(juce::AudioBuffer<float>& buffer, const ModifierContext& context) = 0;
+    /** Audio thread, at the start of every block: apply whatever changed since the last call. */
+    virtual void setParameters(const EngineParameters& params) = 0;
 
     void setActive(bool shouldBeOn) { active = shouldBeOn; }
     bool isActive() const { return active; }
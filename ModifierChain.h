@@ -0,0 +1,80 @@
+// === ModifierChain.h ===
+#pragma once
+#include <JuceHeader.h>
+#include <tuple>
+#include "Modifier.h"
+
+/**
+ * A fixed set of modifiers held by value, run in a per-instance order.
+ *
+ * The types are known at compile time, so visiting a slot is a chain of index
+ * compares that ends in a direct (inlinable) call rather than a virtual one.
+ * Slots are the template argument positions; the order is a permutation of them.
+ */
+template <typename... Modifiers>
+class ModifierChain {
+public:
+    static constexpr int numSlots = (int) sizeof...(Modifiers);
+    using Order = std::array<int, sizeof...(Modifiers)>;
+
+    explicit ModifierChain(const Order& initialOrder) {
+        jassert(isValidOrder(initialOrder));
+        order = initialOrder;
+    }
+
+    template <int Slot> auto& get() { return std::get<Slot>(modifiers); }
+    template <int Slot> const auto& get() const { return std::get<Slot>(modifiers); }
+
+    /** Calls fn(modifier) on every modifier, in slot order. */
+    template <typename Fn>
+    void forEach(Fn&& fn) { std::apply([&fn](auto&... m) { (fn(m), ...); }, modifiers); }
+
+    /** Calls fn(modifier) on the modifier in the given slot; out-of-range slots do nothing. */
+    template <typename Fn>
+    void visit(int slot, Fn&& fn) { visitSlot(*this, slot, fn, std::index_sequence_for<Modifiers...>()); }
+    template <typename Fn>
+    void visit(int slot, Fn&& fn) const { visitSlot(*this, slot, fn, std::index_sequence_for<Modifiers...>()); }
+
+    /** Runs every modifier over the buffer in processing order. */
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext& context) {
+        for (int slot : order)
+            visit(slot, [&](auto& m) { m.process(buffer, context); });
+    }
+
+    /** False (and the order is left alone) unless newOrder names every slot exactly once. */
+    bool setOrder(const Order& newOrder) {
+        if (!isValidOrder(newOrder))
+            return false;
+        order = newOrder;
+        return true;
+    }
+
+    const Order& getOrder() const { return order; }
+
+    /** Where a slot currently runs, 0 being first. */
+    int positionOf(int slot) const {
+        for (int i = 0; i < numSlots; ++i)
+            if (order[(size_t) i] == slot)
+                return i;
+        return -1;
+    }
+
+    static bool isValidOrder(const Order& candidate) {
+        std::array<bool, sizeof...(Modifiers)> seen {};
+        for (int slot : candidate) {
+            if (slot < 0 || slot >= numSlots || seen[(size_t) slot])
+                return false;
+            seen[(size_t) slot] = true;
+        }
+        return true;
+    }
+
+private:
+    template <typename Self, typename Fn, size_t... Slots>
+    static void visitSlot(Self& self, int slot, Fn& fn, std::index_sequence<Slots...>) {
+        (void) ((slot == (int) Slots ? (fn(std::get<Slots>(self.modifiers)), true) : false) || ...);
+    }
+
+    std::tuple<Modifiers...> modifiers;
+    Order order;
+};
@@ -3,28 +3,174 @@
 
 #include <JuceHeader.h>
 #include "Modifier.h"
+#include "ModifierChain.h"
 #include "DebugUtils.h"
+#include "BlockSmoother.h"
+#include "PhaseAccumulator.h"
+#include "BinauralLayers.h"
+#include "SpectralHarmonics.h"
+
+/**
+ * The per-chunk channel loops the modifiers share, specialised on channel
+ * count: mono and stereo are unrolled over write pointers, 0 is the generic
+ * runtime loop for any layout. Each modifier picks its pair once in prepare().
+ */
+template <int NumChannels>
+struct ChannelKernel {
+    static void multiply(juce::AudioBuffer<float>& buffer, int start, const float* gain, int n) {
+        if constexpr (NumChannels == 1) {
+            float* a = buffer.getWritePointer(0, start);
+            for (int i = 0; i < n; ++i) a[i] *= gain[i];
+        } else if constexpr (NumChannels == 2) {
+            float* l = buffer.getWritePointer(0, start);
+            float* r = buffer.getWritePointer(1, start);
+            for (int i = 0; i < n; ++i) { l[i] *= gain[i]; r[i] *= gain[i]; }
+        } else {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch, start), gain, n);
+        }
+    }
+
+    static void add(juce::AudioBuffer<float>& buffer, int start, const float* src, int n) {
+        if constexpr (NumChannels == 1) {
+            float* a = buffer.getWritePointer(0, start);
+            for (int i = 0; i < n; ++i) a[i] += src[i];
+        } else if constexpr (NumChannels == 2) {
+            float* l = buffer.getWritePointer(0, start);
+            float* r = buffer.getWritePointer(1, start);
+            for (int i = 0; i < n; ++i) { l[i] += src[i]; r[i] += src[i]; }
+        } else {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::add(buffer.getWritePointer(ch, start), src, n);
+        }
+    }
+};
+
+struct ChannelOps {
+    using Fn = void (*)(juce::AudioBuffer<float>&, int, const float*, int);
+    Fn multiply = &ChannelKernel<0>::multiply;
+    Fn add = &ChannelKernel<0>::add;
+    int numChannels = 0;
+
+    static ChannelOps forChannels(int numChannels) {
+        if (numChannels == 1) return { &ChannelKernel<1>::multiply, &ChannelKernel<1>::add, 1 };
+        if (numChannels == 2) return { &ChannelKernel<2>::multiply, &ChannelKernel<2>::add, 2 };
+        return { &ChannelKernel<0>::multiply, &ChannelKernel<0>::add, numChannels };
+    }
 
-class BinauralModifier : public Modifier {
+    /** The prepared kernels, or the generic ones if a buffer turns up with a different layout. */
+    const ChannelOps& matching(const juce::AudioBuffer<float>& buffer) const {
+        static const ChannelOps generic;
+        return buffer.getNumChannels() == numChannels ? *this : generic;
+    }
+};
+
+/**
+ * Binaural beat from any mode's carrier, plus stereo width.
+ *
+ * Modes render the carrier and its quadrature (see OscMode). renderPair()
+ * rotates that pair by an offset phase that runs at offsetHz, giving the
+ * right ear cos(carrier + offset): a carrier offsetHz away, exact to the
+ * phase accumulator's resolution whatever the mode is doing with pitch.
+ * process() is the stage in the chain: width on that pair, then any extra
+ * layers (BinauralLayers), each with its own carrier and width.
+ */
+class BinauralModifier final : public Modifier {
 public:
     void prepare(double sampleRate, int, int) override {
         this->sampleRate = sampleRate;
+        width.reset(sampleRate, 0.05);
+        layers.prepare(sampleRate);
     }
 
-    void process(juce::AudioBuffer<float>& buffer) override {
-        juce::ignoreUnused(buffer);
+    /** Carrier in channel 0, quadrature in channel 1 -> the two ears (or two copies of the carrier when off). */
+    void renderPair(juce::AudioBuffer<float>& buffer) {
+        if (buffer.getNumChannels() < 2)
+            return;
+
+        for (int start = 0; start < buffer.getNumSamples(); start += chunkSize)
+            renderPair(buffer.getReadPointer(0, start), buffer.getWritePointer(1, start),
+                       juce::jmin(chunkSize, buffer.getNumSamples() - start));
     }
 
-    void parameterChanged(const juce::String& paramID, float newValue) override {
-        if (paramID == "binauralOffset") {
-            offsetHz = newValue;  // expects -15 to +15 directly
+    /** Up to chunkSize samples; right holds the quadrature on the way in. */
+    void renderPair(const float* carrier, float* right, int n) {
+        if (!enabled) {
+            juce::FloatVectorOperations::copy(right, carrier, n);
+            return;
         }
-        else if (paramID == "binauralWidth") {
-            stereoWidth = newValue * 2.0f - 1.0f; // Scale from 0.0–1.0 to -1.0–+1.0
+
+        const auto increment = PhaseAccumulator::incrementFor(offsetHz, sampleRate);
+        for (int i = 0; i < n; ++i) {
+            const auto p = offsetPhase.next(increment);
+            rotorCos[(size_t) i] = sineTable.cos(p);
+            rotorSin[(size_t) i] = sineTable.sin(p);
         }
+
+        // cos(a + b) = cos a cos b - sin a sin b
+        juce::FloatVectorOperations::multiply(right, rotorCos.data(), n);
+        juce::FloatVectorOperations::multiply(rotorSin.data(), carrier, n);
+        juce::FloatVectorOperations::subtract(right, rotorSin.data(), n);
     }
 
-    void setEnabled(bool e) { enabled = e; }
+    // Narrows or widens the two carriers around their mid, then adds the extra layers. Atmosphere
+    // and harmonics are identical in every channel, so width passes them through unchanged.
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext&) override {
+        if (!enabled || buffer.getNumChannels() < 2 || (!isWidthActive() && !layers.isActive()))
+            return;
+
+        for (int start = 0; start < buffer.getNumSamples(); start += chunkSize) {
+            const int n = juce::jmin(chunkSize, buffer.getNumSamples() - start);
+            float* l = buffer.getWritePointer(0, start);
+            float* r = buffer.getWritePointer(1, start);
+
+            if (isWidthActive())
+                applyWidth(l, r, n);
+            if (layers.isActive())
+                layers.addTo(l, r, n);
+        }
+    }
+
+    bool areLayersActive() const { return layers.isActive(); }
+    void addLayers(float* l, float* r, int n) { layers.addTo(l, r, n); }
+
+    /** False when the width has settled at 1, where the stage changes nothing. */
+    bool isWidthActive() const { return !width.isSettled() || width.getTargetValue() != 1.0f; }
+
+    /** Up to chunkSize samples. Mid/side with vector ops: l = mid + side * w, r = mid - side * w. */
+    void applyWidth(float* l, float* r, int n) {
+        float* mid = midScratch.data();
+        float* side = sideScratch.data();
+
+        juce::FloatVectorOperations::add(mid, l, r, n);
+        juce::FloatVectorOperations::multiply(mid, 0.5f, n);
+        juce::FloatVectorOperations::subtract(side, l, r, n);
+
+        if (width.fill(widthRamp.data(), n)) {
+            juce::FloatVectorOperations::multiply(side, widthRamp.data(), n);
+            juce::FloatVectorOperations::multiply(side, 0.5f, n);
+        } else {
+            juce::FloatVectorOperations::multiply(side, 0.5f * width.getTargetValue(), n);
+        }
+
+        juce::FloatVectorOperations::add(l, mid, side, n);
+        juce::FloatVectorOperations::subtract(r, mid, side, n);
+    }
+
+    static constexpr int chunkSize = 256;
+
+    void setParameters(const EngineParameters& params) override {
+        offsetHz = params.binauralOffset;  // expects -15 to +15 directly
+        stereoWidth = params.binauralWidth * 2.0f - 1.0f; // Scale from 0.0–1.0 to -1.0–+1.0
+        width.setTargetValue(stereoWidth);
+        layers.setParameters(params);
+    }
+
+    void setEnabled(bool e) {
+        if (e && !enabled)
+            offsetPhase = {}; // start in step with the carrier
+        enabled = e;
+    }
     bool isEnabled() const { return enabled; }
 
     float getOffsetHz() const { return offsetHz; }
@@ -35,113 +181,207 @@ private:
     float offsetHz = 0.0f;
     float stereoWidth = 1.0f;
     bool enabled = false;
+
+    BlockSmoother width { 1.0f };
+    BinauralLayers layers;
+    PhaseAccumulator offsetPhase;
+    std::array<float, chunkSize> widthRamp {}, midScratch {}, sideScratch {}, rotorCos {}, rotorSin {};
 };
 
-class BreathModifier : public Modifier {
+class BreathModifier final : public Modifier {
 public:
     void prepare(double sampleRate, int, int numChannels) override {
         this->sampleRate = sampleRate;
-        lfo.reset(sampleRate, 0.1);
-        lfo.setTargetValue(0.0f);
-        phase = 0.0f;
-        lastNumChannels = numChannels;
+        depthSmoother.reset(sampleRate, 0.05);
+        phase = {};
+        channelOps = ChannelOps::forChannels(numChannels);
     }
 
-    void process(juce::AudioBuffer<float>& buffer) override {
-        if (!enabled) return;
-
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext&) override {
         const int numSamples = buffer.getNumSamples();
-        const float phaseInc = juce::MathConstants<float>::twoPi * rate / sampleRate;
+        if (!isActive()) {
+            skip(numSamples);
+            return;
+        }
 
-        for (int i = 0; i < numSamples; ++i) {
-            float maxCut = 1.0f - depth; // depth = 1.0 → no cut, depth = 0.0 → full cut
-            float gainMod = 1.0f - maxCut * 0.5f * (1.0f - std::cos(phase));
-            for (int ch = 0; ch < lastNumChannels; ++ch) {
-                buffer.setSample(ch, i, buffer.getSample(ch, i) * gainMod);
-            }
-            phase += phaseInc;
-            if (phase >= juce::MathConstants<float>::twoPi)
-                phase -= juce::MathConstants<float>::twoPi;
+        const auto& ops = channelOps.matching(buffer);
+
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            const int n = juce::jmin(chunkSize, numSamples - start);
+            fillGain(gainRamp.data(), n);
+            ops.multiply(buffer, start, gainRamp.data(), n);
         }
     }
 
-    void parameterChanged(const juce::String& paramID, float newValue) override {
-        if (paramID == "breathRate") {
-            rate = newValue;
-        } else if (paramID == "breathDepth") {
-            depth = newValue;
+    /**
+     * False once the cut has settled at nothing (disabled, or depth 1), where the gain is
+     * a constant 1. Enabling and disabling ramp the depth, so it never switches mid-cycle.
+     */
+    bool isActive() const { return !depthSmoother.isSettled() || depthSmoother.getTargetValue() < 1.0f; }
+
+    /** Keeps the LFO running through a bypassed stretch, so it comes back in step. */
+    void skip(int n) {
+        phase.phase += PhaseAccumulator::incrementFor(rate, sampleRate) * (juce::uint32) n;
+    }
+
+    /** Writes the breath gain for the next n (up to chunkSize) samples and advances the LFO. */
+    void fillGain(float* gain, int n) {
+        const auto phaseInc = PhaseAccumulator::incrementFor(rate, sampleRate);
+
+        if (!depthSmoother.fill(depthRamp.data(), n))
+            juce::FloatVectorOperations::fill(depthRamp.data(), depthSmoother.getTargetValue(), n);
+
+        for (int i = 0; i < n; ++i) {
+            float maxCut = 1.0f - depthRamp[(size_t) i]; // depth = 1.0 → no cut, depth = 0.0 → full cut
+            gain[i] = 1.0f - maxCut * 0.5f * (1.0f - sineTable.cos(phase.phase));
+            phase.next(phaseInc);
         }
     }
 
-    void setEnabled(bool e) { enabled = e; }
+    static constexpr int chunkSize = 256;
+
+    void setParameters(const EngineParameters& params) override {
+        rate = params.breathRate;
+        depth = params.breathDepth;
+        depthSmoother.setTargetValue(enabled ? depth : 1.0f);
+    }
+
+    void setEnabled(bool e) {
+        enabled = e;
+        depthSmoother.setTargetValue(enabled ? depth : 1.0f); // depth 1 = no cut
+    }
     bool isEnabled() const { return enabled; }
 
 private:
     double sampleRate = 44100.0;
     float rate = 0.25f;
     float depth = 0.5f;
-    float phase = 0.0f;
-    int lastNumChannels = 2;
+    PhaseAccumulator phase;
+    ChannelOps channelOps = ChannelOps::forChannels(2);
     bool enabled = false;
-    juce::SmoothedValue<float> lfo;
+
+    BlockSmoother depthSmoother { 1.0f }; // starts disabled
+    std::array<float, chunkSize> depthRamp {};
+    std::array<float, chunkSize> gainRamp {};
 };
 
-class HarmonicModifier : public Modifier {
+/**
+ * Harmonics 2-9 of the lead mode's frequency, one toggle and level each. In the
+ * spectral engine those eight become the front end of a SpectralHarmonics
+ * envelope over 16-256 partials; in the waveshaper engine they weight Chebyshev
+ * polynomials applied to the carrier itself, so every partial stays locked to it.
+ */
+class HarmonicModifier final : public Modifier {
 public:
-    void prepare(double sampleRate, int, int) override {
+    void prepare(double sampleRate, int, int numChannels) override {
         this->sampleRate = sampleRate;
+        channelOps = ChannelOps::forChannels(numChannels);
+        spectral.prepare(sampleRate);
     }
 
-    void process(juce::AudioBuffer<float>& buffer, float baseFrequency) {
+    // Partials of the lead mode's frequency, centred in every channel; silent while the oscillator is off
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext& context) override {
+        if (!context.isOn || !isActive())
+            return;
 
         const int numSamples = buffer.getNumSamples();
-        const int numChannels = buffer.getNumChannels();
-
-        for (int i = 0; i < numSamples; ++i) {
-            float sum = 0.0f;
-            for (int h = 0; h < 8; ++h) {
-                float gain = smoothedGains[h].getNextValue();
-                if (gain > 0.0001f) {
-                    float freq = baseFrequency * (float)(h + 2);
-                    float phaseInc = freq * twoPi / sampleRate;
-                    phases[h] += phaseInc;
-                    if (phases[h] > twoPi) phases[h] -= twoPi;
-                    sum += gain * harmonicLevels[h] * std::sin(phases[h]);
-                }
-            }
-            float scaled = sum;
-
-            for (int ch = 0; ch < numChannels; ++ch) {
-                float orig = buffer.getSample(ch, i);
-                buffer.setSample(ch, i, orig + scaled);
-            }
+        const auto& ops = channelOps.matching(buffer);
+
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            const int n = juce::jmin(chunkSize, numSamples - start);
+            juce::FloatVectorOperations::clear(sum.data(), n);
+            addTo(sum.data(), n, context.baseFrequency, context.carrier != nullptr ? context.carrier + start : nullptr,
+                  context.carrierIsBlend);
+            if (context.oscillatorGain != nullptr)
+                juce::FloatVectorOperations::multiply(sum.data(), context.oscillatorGain + start, n);
+            ops.add(buffer, start, sum.data(), n);
         }
     }
 
-    void process(juce::AudioBuffer<float>& buffer) override {
-        juce::ignoreUnused(buffer); // Stub to satisfy abstract base class
+    /** False when every partial has faded out, or down to level 0, and is staying there. */
+    bool isActive() const {
+        for (int h = 0; h < 8; ++h)
+            if (!isSilent(smoothedGains[h]) && !isSilent(smoothedLevels[h]))
+                return true;
+        return false;
+    }
+
+    /** True when addTo wants the carrier's samples (the waveshaper engine, or fading from it). */
+    bool needsCarrier() const {
+        return engine == waveshaperEngine || rendered == waveshaperEngine
+            || (engineFadeRemaining > 0 && fadingFrom == waveshaperEngine);
     }
 
-    void parameterChanged(const juce::String& paramID, float newValue) override {
-        for (int i = 2; i <= 9; ++i) {
-            juce::String toggleID = "harmonic" + juce::String(i);
-            juce::String levelID = toggleID + "Level";
+    /**
+     * Adds the next n (up to chunkSize) samples of all active partials to dest. Partials
+     * nearing Nyquist fade out (and past it are skipped) rather than alias, ramped across
+     * the chunk as the base frequency moves. carrier is the lead mode's sine for the same
+     * n samples; without it, or while it's a blend of two modes (whose beating the
+     * waveshaper would turn into intermodulation), the waveshaper engine falls back to
+     * free-running partials. A change of engine crossfades over engineFadeLength samples,
+     * the old engine still rendering (a spectral tail included) as it fades.
+     */
+    void addTo(float* dest, int n, float baseFrequency, const float* carrier = nullptr, bool carrierIsBlend = false) {
+        const bool shapeable = carrier != nullptr && !carrierIsBlend;
+        const Engine wanted = engine == waveshaperEngine && !shapeable ? partialsEngine : engine;
+
+        // One fade at a time; a change made during one starts when it ends
+        if (wanted != rendered && engineFadeRemaining == 0) {
+            if (wanted == spectralEngine)
+                spectral.reset();
+            if (wanted == waveshaperEngine)
+                shaperPrimed = false;
+            fadingFrom = rendered;
+            rendered = wanted;
+            engineFadeRemaining = engineFadeLength;
+        }
 
-            if (paramID == toggleID) {
-                int hIndex = i - 2;
-                if (newValue > 0.5f) {
-                    smoothedGains[hIndex].reset(sampleRate, harmonicAttackTime);
-                    smoothedGains[hIndex].setTargetValue(1.0f);
-                } else {
-                    smoothedGains[hIndex].reset(sampleRate, harmonicReleaseTime);
-                    smoothedGains[hIndex].setTargetValue(0.0f);
-                }
-            } else if (paramID == levelID) {
-                int hIndex = i - 2;
-                harmonicLevels[hIndex] = newValue;
-            }
+        if (engineFadeRemaining == 0) {
+            addEngine(rendered, dest, n, baseFrequency, carrier);
+            return;
         }
 
+        // Both engines read the same toggle and level ramps, so the old one renders from a copy
+        const auto gains = smoothedGains;
+        const auto levels = smoothedLevels;
+        juce::FloatVectorOperations::clear(fadeOut.data(), n);
+        addEngine(fadingFrom, fadeOut.data(), n, baseFrequency, carrier);
+        smoothedGains = gains;
+        smoothedLevels = levels;
+
+        juce::FloatVectorOperations::clear(fadeIn.data(), n);
+        addEngine(rendered, fadeIn.data(), n, baseFrequency, carrier);
+
+        for (int i = 0; i < n; ++i) {
+            const float out = (float) juce::jmax(0, engineFadeRemaining - 1 - i) / (float) engineFadeLength;
+            dest[i] += fadeOut[(size_t) i] * out + fadeIn[(size_t) i] * (1.0f - out);
+        }
+        engineFadeRemaining = juce::jmax(0, engineFadeRemaining - n);
+    }
+
+    static constexpr int chunkSize = 256;
+
+    void setParameters(const EngineParameters& params) override {
+        // addTo() crossfades to it
+        engine = (Engine) juce::jlimit((int) partialsEngine, (int) waveshaperEngine, params.harmonicEngine);
+
+        spectral.setNumPartials(params.harmonicCount);
+        spectral.setTilt(params.spectralTilt);
+        spectral.setOddEven(params.spectralOddEven);
+        spectral.setFormantFrequency(params.spectralFormantFrequency);
+        spectral.setFormantGain(params.spectralFormantGain);
+
+        for (int h = 0; h < 8; ++h) {
+            // Toggles fade in quickly and out slowly; the ramp time is set with each new target
+            const float gainTarget = params.harmonicOn[(size_t) h] ? 1.0f : 0.0f;
+            if (gainTarget != smoothedGains[h].getTargetValue()) {
+                smoothedGains[h].setRampTime(gainTarget > 0.0f ? harmonicAttackTime : harmonicReleaseTime);
+                smoothedGains[h].setTargetValue(gainTarget);
+            }
+
+            harmonicLevels[h] = params.harmonicLevel[(size_t) h];
+            smoothedLevels[h].setTargetValue(harmonicLevels[h]);
+        }
     }
     void setEnabled(bool e) { enabled = e; }
     bool isEnabled() const { return enabled; }
@@ -149,25 +389,213 @@ public:
     void setSampleRate(double newRate)
     {
         sampleRate = newRate;
+        bandGains.fill(bandGainUnknown);
         for (auto& g : smoothedGains) {
-            g.reset(sampleRate);
+            g.reset(sampleRate, harmonicAttackTime);
             g.setCurrentAndTargetValue(0.0f);
         }
+        for (int h = 0; h < 8; ++h) {
+            smoothedLevels[h].reset(sampleRate, 0.05);
+            smoothedLevels[h].setCurrentAndTargetValue(harmonicLevels[h]);
+        }
     }
 
 private:
+    static bool isSilent(const BlockSmoother& s) { return s.isSettled() && s.getTargetValue() == 0.0f; }
+
+    enum Engine { partialsEngine, spectralEngine, waveshaperEngine };
+
+    void addEngine(Engine which, float* dest, int n, float baseFrequency, const float* carrier) {
+        if (which == spectralEngine) {
+            bandGains.fill(bandGainUnknown);
+            addSpectral(dest, n, baseFrequency);
+        } else if (which == waveshaperEngine && carrier != nullptr) {
+            bandGains.fill(bandGainUnknown);
+            addWaveshaped(dest, n, baseFrequency, carrier);
+        } else {
+            addPartials(dest, n, baseFrequency);
+        }
+    }
+
+    // One sine per partial, each on its own phase
+    void addPartials(float* dest, int n, float baseFrequency) {
+        for (int h = 0; h < 8; ++h) {
+            // Faded out and staying out, or at level 0: the partial costs nothing
+            if (isSilent(smoothedGains[h])) {
+                bandGains[h] = bandGainUnknown;
+                continue;
+            }
+            if (isSilent(smoothedLevels[h])) {
+                bandGains[h] = bandGainUnknown;
+                smoothedGains[h].skip(n);
+                continue;
+            }
+
+            // A partial that wasn't rendered last chunk has no gain to ramp from, so it starts at its own
+            const float partialFrequency = baseFrequency * (float) (h + 2);
+            const float bandEnd = bandLimitGain(partialFrequency);
+            const float bandStart = bandGains[h] == bandGainUnknown ? bandEnd : bandGains[h];
+            bandGains[h] = bandEnd;
+            if (bandStart == 0.0f && bandEnd == 0.0f) {
+                smoothedGains[h].skip(n);
+                smoothedLevels[h].skip(n);
+                continue;
+            }
+
+            // Toggle gain times level, as a ramp only while either is still moving
+            const bool gainRamping = smoothedGains[h].fill(gainRamp.data(), n);
+            const bool levelRamping = smoothedLevels[h].fill(levelRamp.data(), n);
+
+            if (!gainRamping)
+                juce::FloatVectorOperations::fill(gainRamp.data(), smoothedGains[h].getTargetValue(), n);
+            if (levelRamping)
+                juce::FloatVectorOperations::multiply(gainRamp.data(), levelRamp.data(), n);
+            else
+                juce::FloatVectorOperations::multiply(gainRamp.data(), smoothedLevels[h].getTargetValue(), n);
+
+            if (bandStart != 1.0f || bandEnd != 1.0f) {
+                const float step = (bandEnd - bandStart) / (float) n;
+                for (int i = 0; i < n; ++i)
+                    gainRamp[(size_t) i] *= bandStart + step * (float) (i + 1);
+            }
+
+            const auto phaseInc = PhaseAccumulator::incrementFor(partialFrequency, sampleRate);
+            for (int i = 0; i < n; ++i)
+                dest[i] += gainRamp[(size_t) i] * sineTable.sin(phases[h].next(phaseInc));
+        }
+    }
+
+    // The toggles and faders, sampled once per chunk, shape the spectral envelope
+    void addSpectral(float* dest, int n, float baseFrequency) {
+        std::array<float, SpectralHarmonics::numFrontEndGains> frontEnd;
+        for (int h = 0; h < 8; ++h) {
+            smoothedGains[h].skip(n);
+            smoothedLevels[h].skip(n);
+            frontEnd[(size_t) h] = smoothedGains[h].getCurrentValue() * smoothedLevels[h].getCurrentValue();
+        }
+
+        spectral.addTo(dest, n, baseFrequency, frontEnd, [this](float f) { return bandLimitGain(f); });
+    }
+
+    static constexpr int shaperDegree = 9; // harmonic 9 needs T_9
+    using ShaperPolynomial = std::array<float, shaperDegree + 1>; // power-series coefficients, x^0 first
+
+    // Power-series coefficients of the Chebyshev polynomials T_0..T_9, by T_k+1 = 2x T_k - T_k-1
+    static constexpr auto chebyshev = [] {
+        std::array<ShaperPolynomial, shaperDegree + 1> t {};
+        t[0][0] = 1.0f;
+        t[1][1] = 1.0f;
+        for (int k = 2; k <= shaperDegree; ++k)
+            for (int j = 0; j <= k; ++j)
+                t[(size_t) k][(size_t) j] = (j > 0 ? 2.0f * t[(size_t) k - 1][(size_t) j - 1] : 0.0f) - t[(size_t) k - 2][(size_t) j];
+        return t;
+    }();
+
+    static float horner(const ShaperPolynomial& c, int degree, float x) {
+        float y = c[(size_t) degree];
+        for (int j = degree - 1; j >= 0; --j)
+            y = y * x + c[(size_t) j];
+        return y;
+    }
+
+    /**
+     * T_k(sin t) is sin(kt) or cos(kt) up to sign, so one polynomial in the carrier's own
+     * samples gives all eight partials, phase-locked to it. The polynomial is rebuilt
+     * from the toggles, faders and band limit each chunk and crossfaded from the last one.
+     */
+    void addWaveshaped(float* dest, int n, float baseFrequency, const float* carrier) {
+        ShaperPolynomial target {};
+        int degree = 0;
+        for (int h = 0; h < 8; ++h) {
+            smoothedGains[h].skip(n);
+            smoothedLevels[h].skip(n);
+
+            // Below 1 Hz the mode is off and its carrier is silent, where the even T_k sit at +-1
+            const int k = h + 2;
+            const float weight = baseFrequency < 1.0f ? 0.0f
+                               : smoothedGains[h].getCurrentValue() * smoothedLevels[h].getCurrentValue()
+                                     * bandLimitGain(baseFrequency * (float) k);
+            if (weight == 0.0f)
+                continue;
+
+            // T_k(sin t) = (-1)^(k/2) times sin(kt) for odd k, cos(kt) for even k
+            const float signedWeight = (k / 2) % 2 == 0 ? weight : -weight;
+            for (int j = 0; j <= k; ++j)
+                target[(size_t) j] += signedWeight * chebyshev[(size_t) k][(size_t) j];
+            degree = k;
+        }
+
+        if (!shaperPrimed) {
+            shaper = target;
+            shaperDegreeInUse = degree;
+            shaperPrimed = true;
+        }
+
+        const auto start = shaper;
+        const int startDegree = shaperDegreeInUse;
+        shaper = target;
+        shaperDegreeInUse = degree;
+        degree = juce::jmax(degree, startDegree);
+        if (degree == 0)
+            return;
+
+        if (start == target) {
+            for (int i = 0; i < n; ++i)
+                dest[i] += horner(target, degree, juce::jlimit(-1.0f, 1.0f, carrier[i]));
+            return;
+        }
+
+        ShaperPolynomial delta;
+        for (size_t j = 0; j < delta.size(); ++j)
+            delta[j] = target[j] - start[j];
+
+        const float step = 1.0f / (float) n;
+        for (int i = 0; i < n; ++i) {
+            const float x = juce::jlimit(-1.0f, 1.0f, carrier[i]);
+            dest[i] += horner(start, degree, x) + step * (float) (i + 1) * horner(delta, degree, x);
+        }
+    }
+
+    // Full level up to bandLimitStart * sampleRate, silent from bandLimitEnd * sampleRate (Nyquist is 0.5)
+    static constexpr float bandLimitStart = 0.40f;
+    static constexpr float bandLimitEnd = 0.45f;
+
+    float bandLimitGain(float frequency) const {
+        const float full = bandLimitStart * (float) sampleRate;
+        const float none = bandLimitEnd * (float) sampleRate;
+        if (frequency <= full) return 1.0f;
+        if (frequency >= none) return 0.0f;
+        return (none - frequency) / (none - full);
+    }
+
     double sampleRate = 44100.0;
     std::array<float, 8> harmonicLevels = { 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f };
-    std::array<float, 8> phases = { 0 };
-    std::array<juce::SmoothedValue<float>, 8> smoothedGains;
+    std::array<PhaseAccumulator, 8> phases {};
+    Engine engine = partialsEngine;     // as selected
+    Engine rendered = partialsEngine;   // as last rendered, which the waveshaper falls back from
+    Engine fadingFrom = partialsEngine;
+    int engineFadeRemaining = 0;
+    static constexpr int engineFadeLength = chunkSize;
+    std::array<float, chunkSize> fadeOut {}, fadeIn {};
+    SpectralHarmonics spectral;
+    ShaperPolynomial shaper {};    // the waveshaper's polynomial at the end of the last chunk
+    int shaperDegreeInUse = 0;
+    bool shaperPrimed = false;
+    static constexpr float bandGainUnknown = -1.0f;
+    std::array<float, 8> bandGains { bandGainUnknown, bandGainUnknown, bandGainUnknown, bandGainUnknown,
+                                     bandGainUnknown, bandGainUnknown, bandGainUnknown, bandGainUnknown }; // band-limit gain at the end of the last chunk
+    std::array<BlockSmoother, 8> smoothedGains;
+    std::array<BlockSmoother, 8> smoothedLevels { BlockSmoother(0.5f), BlockSmoother(0.5f), BlockSmoother(0.5f), BlockSmoother(0.5f),
+                                                  BlockSmoother(0.5f), BlockSmoother(0.5f), BlockSmoother(0.5f), BlockSmoother(0.5f) };
+    std::array<float, chunkSize> gainRamp {}, levelRamp {}, sum {};
+    ChannelOps channelOps = ChannelOps::forChannels(2);
     static constexpr float harmonicAttackTime = 0.05f;
     static constexpr float harmonicReleaseTime = 1.5f;
-    const float twoPi = juce::MathConstants<float>::twoPi;
     bool enabled = false;
 
 };
 
-class AtmosphereModifier : public Modifier {
+class AtmosphereModifier final : public Modifier {
 public:
     enum AtmosphereType {
         Off = 0,
@@ -183,6 +611,7 @@ public:
     void prepare(double sampleRate, int, int numChannels) override {
         this->sampleRate = sampleRate;
         this->numChannels = numChannels;
+        channelOps = ChannelOps::forChannels(numChannels);
         
         // Initialize pink noise filter (simple first-order)
         pinkFilterState = 0.0f;
@@ -190,62 +619,104 @@ public:
         // Simple filter states for different atmospheres
         windFilterState1 = 0.0f;
         windFilterState2 = 0.0f;
+        windMid = 0.0f;
         rainFilterState = 0.0f;
+        forestLow = forestHigh = 0.0f;
+        birdsLow = 0.0f;
         
         // Ocean wave oscillators - simple phase tracking
-        for (int i = 0; i < 3; ++i) {
-            oceanPhases[i] = 0.0f;
-        }
         oceanFreqs[0] = 0.1f;
         oceanFreqs[1] = 0.3f;
         oceanFreqs[2] = 0.7f;
+        for (int i = 0; i < 3; ++i) {
+            oceanPhases[i] = {};
+            oceanIncrements[i] = PhaseAccumulator::incrementFor(oceanFreqs[i], sampleRate);
+        }
+
+        gain.reset(sampleRate, 0.05);
     }
 
-    void process(juce::AudioBuffer<float>& buffer) override {
-        if (currentType == Off || !enabled) return;
-        
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext&) override {
+        if (!isActive()) return;
+
         const int numSamples = buffer.getNumSamples();
-        
-        // Generate atmosphere audio
-        for (int sample = 0; sample < numSamples; ++sample) {
-            float atmosphereValue = generateAtmosphereSample();
-            
-            // Apply gain (converted from dB)
-            float finalGain = juce::Decibels::decibelsToGain(gainDb);
-            atmosphereValue *= finalGain;
-            
+        const auto& ops = channelOps.matching(buffer);
+
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            const int n = juce::jmin(chunkSize, numSamples - start);
+
+            juce::FloatVectorOperations::clear(mix.data(), n);
+            addTo(mix.data(), n);
+
             // Add to all channels
-            for (int ch = 0; ch < numChannels; ++ch) {
-                float currentSample = buffer.getSample(ch, sample);
-                buffer.setSample(ch, sample, currentSample + atmosphereValue);
-            }
+            ops.add(buffer, start, mix.data(), n);
         }
     }
 
-    void parameterChanged(const juce::String& paramID, float newValue) override {
-        if (paramID == "atmoType") {
-            currentType = static_cast<AtmosphereType>(static_cast<int>(newValue));
-            DBG("Atmosphere type changed to: " << static_cast<int>(currentType));
-        } else if (paramID == "atmoLevel") {
+    /** False once faded out (disabled, Off or level 0), at which point the stage is skipped. */
+    bool isActive() const { return !gain.isSettled() || gain.getTargetValue() != 0.0f; }
+
+    /** Adds the next n (up to chunkSize) samples of atmosphere, with gain applied, to dest. */
+    void addTo(float* dest, int n) {
+        // Generate atmosphere audio
+        for (int i = 0; i < n; ++i)
+            scratch[(size_t) i] = generateAtmosphereSample();
+
+        gain.applyGain(scratch.data(), n);
+        juce::FloatVectorOperations::add(dest, scratch.data(), n);
+
+        flushFilterStates();
+    }
+
+    static constexpr int chunkSize = 256;
+
+    void setParameters(const EngineParameters& params) override {
+        const auto type = static_cast<AtmosphereType>(juce::jlimit((int) Off, (int) Birds, params.atmoType));
+        if (type != currentType) {
+            currentType = type;
+            if (currentType != Off)
+                playingType = currentType; // Off keeps the last type going while it fades
+            updateGainTarget();
+        }
+
+        if (params.atmoLevel != level) {
+            level = params.atmoLevel;
             // Convert from 0.0-1.0 to -inf to 0.0 dB
-            if (newValue <= 0.0001f) {
+            if (level <= 0.0001f) {
                 gainDb = -60.0f; // Effectively -inf
+                levelGain = 0.0f; // and silent, so the stage can be skipped
             } else {
-                gainDb = 20.0f * std::log10(newValue); // Convert to dB
+                gainDb = 20.0f * std::log10(level); // Convert to dB
+                levelGain = juce::Decibels::decibelsToGain(gainDb);
             }
-            DBG("Atmosphere level changed to: " << gainDb << " dB");
+            updateGainTarget();
         }
     }
 
-    void setEnabled(bool e) { enabled = e; }
+    void setEnabled(bool e) {
+        enabled = e;
+        updateGainTarget();
+    }
     bool isEnabled() const { return enabled; }
 
 private:
     double sampleRate = 44100.0;
     int numChannels = 2;
     AtmosphereType currentType = Off;
+    AtmosphereType playingType = Off;
+    float level = -1.0f;   // the last atmoLevel applied; none yet
     float gainDb = -12.0f; // Start at -12dB (quiet background)
+    float levelGain = juce::Decibels::decibelsToGain(-12.0f);
     bool enabled = false;
+
+    // Converted from dB once per change, smoothed as linear gain. Switching off fades it to 0.
+    BlockSmoother gain { 0.0f };
+
+    void updateGainTarget() {
+        gain.setTargetValue(enabled && currentType != Off ? levelGain : 0.0f);
+    }
+    std::array<float, chunkSize> scratch {}, mix {};
+    ChannelOps channelOps = ChannelOps::forChannels(2);
     
     // Audio generation components
     juce::Random random;
@@ -255,13 +726,30 @@ private:
     float windFilterState1 = 0.0f;
     float windFilterState2 = 0.0f;
     float rainFilterState = 0.0f;
+    float windMid = 0.0f;
+    float forestLow = 0.0f, forestHigh = 0.0f;
+    float birdsLow = 0.0f;
+
+    // A state whose input has gone quiet decays towards 0 and ends up denormal, which is
+    // slow on x86 without FTZ. Snapped once per chunk; far below anything audible.
+    void flushFilterStates() {
+        JUCE_SNAP_TO_ZERO(pinkFilterState);
+        JUCE_SNAP_TO_ZERO(windFilterState1);
+        JUCE_SNAP_TO_ZERO(windFilterState2);
+        JUCE_SNAP_TO_ZERO(windMid);
+        JUCE_SNAP_TO_ZERO(rainFilterState);
+        JUCE_SNAP_TO_ZERO(forestLow);
+        JUCE_SNAP_TO_ZERO(forestHigh);
+        JUCE_SNAP_TO_ZERO(birdsLow);
+    }
     
     // Ocean oscillator phases and frequencies
-    float oceanPhases[3];
+    PhaseAccumulator oceanPhases[3];
+    juce::uint32 oceanIncrements[3] = {};
     float oceanFreqs[3];
     
     float generateAtmosphereSample() {
-        switch (currentType) {
+        switch (playingType) {
             case Off:
                 return 0.0f;
                 
@@ -311,7 +799,6 @@ private:
         windFilterState2 += cutoff * (windFilterState1 - windFilterState2);
         
         // Add some very gentle mid-frequency content
-        static float windMid = 0.0f;
         windMid += 0.02f * (noise - windMid);
         
         return (windFilterState2 * 1.5f + windMid * 0.3f) * 0.4f; // Much quieter
@@ -337,11 +824,8 @@ private:
         float waves = 0.0f;
         
         for (int i = 0; i < 3; ++i) {
-            waves += std::sin(oceanPhases[i]) * (0.15f - i * 0.05f); // Quieter waves
-            oceanPhases[i] += 2.0f * juce::MathConstants<float>::pi * oceanFreqs[i] / static_cast<float>(sampleRate);
-            if (oceanPhases[i] > 2.0f * juce::MathConstants<float>::pi) {
-                oceanPhases[i] -= 2.0f * juce::MathConstants<float>::pi;
-            }
+            waves += sineTable.sin(oceanPhases[i].phase) * (0.15f - i * 0.05f); // Quieter waves
+            oceanPhases[i].next(oceanIncrements[i]);
         }
         
         // Very gentle background noise
@@ -355,9 +839,6 @@ private:
         float noise = generateWhiteNoise() * 0.5f; // Start with quieter noise
         
         // Very gentle filtering
-        static float forestLow = 0.0f;
-        static float forestHigh = 0.0f;
-        
         forestLow += 0.02f * (noise - forestLow); // Gentler filtering
         forestHigh = noise - forestLow;
         
@@ -369,7 +850,6 @@ private:
         float noise = generateWhiteNoise() * 0.3f; // Start quieter
         
         // Gentler filtering
-        static float birdsLow = 0.0f;
         birdsLow += 0.1f * (noise - birdsLow); // Less aggressive filtering
         float chirpy = noise - birdsLow;
         
@@ -384,57 +864,101 @@ private:
 
 class ModifierEngine {
 public:
+    // Slot indices, as used by the UI and the saved enable flags
+    enum Slot { binauralSlot, breathSlot, harmonicSlot, atmosphereSlot };
+
+    using Chain = ModifierChain<BinauralModifier, BreathModifier, HarmonicModifier, AtmosphereModifier>;
+    using Order = Chain::Order;
+    static constexpr int numSlots = Chain::numSlots;
+
+    // Harmonics and atmosphere join the carrier, width spreads it, breath shapes the whole mix
+    static constexpr Order defaultOrder { harmonicSlot, atmosphereSlot, binauralSlot, breathSlot };
+
     void prepare(double sampleRate, int blockSize, int numChannels) {
-        binaural.prepare(sampleRate, blockSize, numChannels);
-        breath.prepare(sampleRate, blockSize, numChannels);
-        harmonic.setSampleRate(sampleRate);
-        harmonic.prepare(sampleRate, blockSize, numChannels);
-        atmosphere.prepare(sampleRate, blockSize, numChannels);  // Add this line
+        harmonic().setSampleRate(sampleRate);
+        carrierScratch.assign((size_t) juce::jmax(0, blockSize), 0.0f);
+        chain.forEach([&](auto& m) { m.prepare(sampleRate, blockSize, numChannels); });
     }
 
-    void process(juce::AudioBuffer<float>& buffer) {
-        // Add atmosphere to the buffer (it will be affected by breath LFO later)
-        atmosphere.process(buffer);
-        
-        // Apply binaural processing (only affects main oscillator, not atmosphere)
-        binaural.process(buffer);
-        
-        // Apply breath LFO last (affects everything including atmosphere)
-        breath.process(buffer);
-    }
+    /**
+     * The buffer arrives as the modes render it (carrier, then quadrature in channel 1).
+     * The ears are formed first, so every slot order sees finished left/right carriers.
+     * A waveshaping harmonic engine gets a copy of the carrier taken before that, and
+     * before the on/off fade, so a fading carrier doesn't change the shaped timbre.
+     */
+    void process(juce::AudioBuffer<float>& buffer, const ModifierContext& context) {
+        auto withCarrier = context;
+        if (harmonic().needsCarrier() && buffer.getNumSamples() <= (int) carrierScratch.size()) {
+            juce::FloatVectorOperations::copy(carrierScratch.data(), buffer.getReadPointer(0), buffer.getNumSamples());
+            withCarrier.carrier = carrierScratch.data();
+        }
+
+        if (context.oscillatorGain != nullptr)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch), context.oscillatorGain, buffer.getNumSamples());
 
-    void parameterChanged(const juce::String& id, float value) {
-        binaural.parameterChanged(id, value);
-        breath.parameterChanged(id, value);
-        harmonic.parameterChanged(id, value);
-        atmosphere.parameterChanged(id, value);  // Add this line
+        binaural().renderPair(buffer);
+        chain.process(buffer, withCarrier);
     }
 
-    void setModifierEnabled(int slotIndex, bool enable) {
-        if (slotIndex == 0) binaural.setEnabled(enable);
-        else if (slotIndex == 1) breath.setEnabled(enable);
-        else if (slotIndex == 2) harmonic.setEnabled(enable);
-        else if (slotIndex == 3) atmosphere.setEnabled(enable);  // Add this line
+    /** Audio thread, once per block. */
+    void setParameters(const EngineParameters& params) {
+        chain.forEach([&](auto& m) { m.setParameters(params); });
     }
 
-    void process(juce::AudioBuffer<float>& buffer, float baseFrequency) {
-        harmonic.process(buffer, baseFrequency);
+    void setModifierEnabled(int slotIndex, bool enable) {
+        chain.visit(slotIndex, [enable](auto& m) { m.setEnabled(enable); });
     }
 
     bool isModifierEnabled(int slotIndex) const {
-        if (slotIndex == 0) return binaural.isEnabled();
-        else if (slotIndex == 1) return breath.isEnabled();
-        else if (slotIndex == 2) return harmonic.isEnabled();
-        else if (slotIndex == 3) return atmosphere.isEnabled();  // Add this line
-        return false;
+        bool enabled = false;
+        chain.visit(slotIndex, [&enabled](const auto& m) { enabled = m.isEnabled(); });
+        return enabled;
     }
 
-    float getOffsetHz() const { return binaural.getOffsetHz(); }
-    float getStereoWidth() const { return binaural.getStereoWidth(); }
+    /** Audio thread. False if the order isn't a permutation of the slots. */
+    bool setOrder(const Order& newOrder) { return chain.setOrder(newOrder); }
+    const Order& getOrder() const { return chain.getOrder(); }
+    static bool isValidOrder(const Order& order) { return Chain::isValidOrder(order); }
+
+    float getOffsetHz() const { return binaural().getOffsetHz(); }
+    float getStereoWidth() const { return binaural().getStereoWidth(); }
+
+    // Chunk-level stages for the processor's fused render path; n is at most chunkSize
+    static constexpr int chunkSize = 256;
+    void renderBinauralPair(const float* carrier, float* right, int n) { binaural().renderPair(carrier, right, n); }
+    bool isWidthActive() const { return binaural().isEnabled() && binaural().isWidthActive(); }
+    void applyWidth(float* left, float* right, int n) { binaural().applyWidth(left, right, n); }
+    bool areBinauralLayersActive() const { return binaural().isEnabled() && binaural().areLayersActive(); }
+    void addBinauralLayers(float* left, float* right, int n) { binaural().addLayers(left, right, n); }
+    bool isHarmonicsActive() const { return harmonic().isActive(); }
+    void addHarmonics(float* dest, int n, float baseFrequency, const float* carrier) { harmonic().addTo(dest, n, baseFrequency, carrier); }
+    bool isAtmosphereActive() const { return atmosphere().isActive(); }
+    void addAtmosphere(float* dest, int n) { atmosphere().addTo(dest, n); }
+    bool isBreathActive() const { return breath().isActive(); }
+    void fillBreathGain(float* gain, int n) { breath().fillGain(gain, n); }
+    void skipBreath(int n) { breath().skip(n); }
+
+    /**
+     * The fused path adds harmonics, atmosphere and the binaural layers before breath. Width
+     * commutes with centred sources and with gain, so that holds whenever breath runs after all three.
+     */
+    bool breathFollowsSources() const {
+        const int breathAt = chain.positionOf(breathSlot);
+        return breathAt > chain.positionOf(harmonicSlot) && breathAt > chain.positionOf(atmosphereSlot)
+            && breathAt > chain.positionOf(binauralSlot);
+    }
 
 private:
-    BinauralModifier binaural;
-    BreathModifier breath;
-    HarmonicModifier harmonic;
-    AtmosphereModifier atmosphere;  // Add this line
+    Chain chain { defaultOrder };
+    std::vector<float> carrierScratch; // the carrier before the ears are formed, for the waveshaper
+
+    BinauralModifier& binaural() { return chain.get<binauralSlot>(); }
+    const BinauralModifier& binaural() const { return chain.get<binauralSlot>(); }
+    BreathModifier& breath() { return chain.get<breathSlot>(); }
+    const BreathModifier& breath() const { return chain.get<breathSlot>(); }
+    HarmonicModifier& harmonic() { return chain.get<harmonicSlot>(); }
+    const HarmonicModifier& harmonic() const { return chain.get<harmonicSlot>(); }
+    AtmosphereModifier& atmosphere() { return chain.get<atmosphereSlot>(); }
+    const AtmosphereModifier& atmosphere() const { return chain.get<atmosphereSlot>(); }
 };
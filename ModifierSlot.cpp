@@ -6,21 +6,6 @@
 
 extern CenteredSliderLookAndFeel centeredLook;
 
-juce::Colour getHarmonicColor(int index)
-{
-    static std::array<juce::Colour, 8> colors = {
-        juce::Colours::red,
-        juce::Colours::orange,
-        juce::Colours::yellow,
-        juce::Colours::green,
-        juce::Colours::blue,
-        juce::Colours::indigo,
-        juce::Colours::violet,
-        juce::Colours::pink
-    };
-    return colors[index % colors.size()];
-}
-
 ModifierSlot::ModifierSlot(int index, SimpleOscAudioProcessor& proc)
     : slotIndex(index), processor(proc)
 {
@@ -156,49 +141,49 @@ ModifierSlot::ModifierSlot(int index, SimpleOscAudioProcessor& proc)
                         // Use convertTo0to1 for proper parameter conversion
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(0.0f));
-                        processor.modifierEngine.setModifierEnabled(3, false);
+                        processor.setModifierEnabled(3, false);
                     }
                     else if (result == 2) {
                         atmoSelector->setButtonText("White Noise");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(1.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 3) {
                         atmoSelector->setButtonText("Pink Noise");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(2.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 4) {
                         atmoSelector->setButtonText("Wind");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(3.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 5) {
                         atmoSelector->setButtonText("Rain");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(4.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 6) {
                         atmoSelector->setButtonText("Ocean");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(5.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 7) {
                         atmoSelector->setButtonText("Forest");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(6.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                     else if (result == 8) {
                         atmoSelector->setButtonText("Birds");
                         auto* param = processor.parameters.getParameter("atmoType");
                         param->setValueNotifyingHost(param->convertTo0to1(7.0f));
-                        processor.modifierEngine.setModifierEnabled(3, true);
+                        processor.setModifierEnabled(3, true);
                     }
                 });
         };
@@ -276,6 +261,36 @@ void ModifierSlot::mouseDrag(const juce::MouseEvent& e) {
         showValuePopupFromSlider(*widthSlider);
 }
 
+void ModifierSlot::mouseDown(const juce::MouseEvent& e) {
+    // Right-click on the slot itself (not its controls) moves it through the processing order
+    if (e.eventComponent == this && e.mods.isPopupMenu())
+        showOrderMenu();
+}
+
+void ModifierSlot::showOrderMenu() {
+    auto order = processor.getModifierOrder();
+    const auto it = std::find(order.begin(), order.end(), slotIndex);
+    if (it == order.end())
+        return;
+
+    const int position = (int) std::distance(order.begin(), it);
+    juce::PopupMenu menu;
+    menu.addSectionHeader("Processing order: " + juce::String(position + 1) + " of " + juce::String((int) order.size()));
+    menu.addItem(1, "Run earlier", position > 0);
+    menu.addItem(2, "Run later", position < (int) order.size() - 1);
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this),
+        [this, order, position](int result) mutable {
+            if (result == 1)
+                std::swap(order[(size_t) position], order[(size_t) position - 1]);
+            else if (result == 2)
+                std::swap(order[(size_t) position], order[(size_t) position + 1]);
+            else
+                return;
+            processor.setModifierOrder(order);
+        });
+}
+
 void ModifierSlot::resized() {
     auto area = getLocalBounds().reduced(6);
 
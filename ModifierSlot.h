@@ -13,6 +13,7 @@ public:
     void mouseEnter(const juce::MouseEvent& e) override;
     void mouseExit(const juce::MouseEvent&) override;
     void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseDown(const juce::MouseEvent& e) override;
     void setBinauralState(bool isOn);
 
     // === Slot 0: Binaural ===
@@ -50,6 +51,7 @@ private:
     
     void showValuePopupFromSlider(juce::Slider&);
     void hideValuePopup();
+    void showOrderMenu();
 
 
 };
@@ -1,9 +1,16 @@
 // === OscMode.h ===
 #pragma once
 #include <JuceHeader.h>
+#include "PhaseAccumulator.h"
+#include "EngineParameters.h"
 
 /**
  * Abstract interface for oscillator modes.
+ *
+ * A mode renders a single carrier: channel 0 gets the carrier, channel 1 (if
+ * any) its quadrature, a quarter cycle ahead, and any further channels the
+ * carrier again. The binaural stage builds the right ear from the quadrature,
+ * so modes don't need to know about it.
  */
 struct OscMode
 {
@@ -12,6 +19,25 @@ struct OscMode
     virtual void processBlock(juce::AudioBuffer<float>& buffer,
                               juce::MidiBuffer& midiMessages,
                               bool isOn) = 0;
-    virtual void parameterChanged(const juce::String& paramID,
-                                  float newValue) = 0;
+
+    /**
+     * Called at the start of every block on the audio thread (and once before a new
+     * mode is handed over). Apply whatever changed since the last call.
+     */
+    virtual void setParameters(const EngineParameters& params) = 0;
+
+    /** Carrier phase (a PhaseAccumulator value), handed to the next mode on a switch. */
+    virtual juce::uint32 getPhase() const { return 0; }
+    virtual void setPhase(juce::uint32) {}
+
+    /** Base frequency of the last block, which the harmonics follow. */
+    virtual float getFrequency() const { return 0.0f; }
+
+    /**
+     * Chunk-level carrier for the processor's fused render path. Modes that
+     * support it write n (up to 256) samples to carrier, and the quadrature
+     * when that isn't null; processBlock should be built on the same call.
+     */
+    virtual bool canRenderChunks() const { return false; }
+    virtual void renderChunk(float* carrier, float* quadrature, int n) { juce::ignoreUnused(carrier, quadrature, n); }
 };
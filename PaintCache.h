@@ -0,0 +1,53 @@
+// === PaintCache.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Holds a pre-rendered ARGB layer keyed by its bounds and a caller supplied
+ * state key. The render callback only runs when the bounds or state change
+ * (or after invalidate()), otherwise paint() is a single image blit.
+ *
+ * The layer is rendered at the context's physical pixel scale so cached
+ * paths stay crisp on HiDPI displays.
+ */
+class CachedLayer
+{
+public:
+    void invalidate() { image = {}; }
+
+    template <typename RenderFn>
+    void draw(juce::Graphics& g, juce::Rectangle<int> bounds, juce::int64 stateKey, RenderFn&& render)
+    {
+        if (bounds.isEmpty())
+            return;
+
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (! image.isValid() || bounds != cachedBounds || stateKey != cachedState || scale != cachedScale)
+        {
+            cachedBounds = bounds;
+            cachedState = stateKey;
+            cachedScale = scale;
+
+            image = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt((float) bounds.getWidth() * scale)),
+                                juce::jmax(1, juce::roundToInt((float) bounds.getHeight() * scale)),
+                                true);
+
+            juce::Graphics ig(image);
+            ig.addTransform(juce::AffineTransform::translation((float) -bounds.getX(), (float) -bounds.getY())
+                                .scaled(scale));
+            render(ig); // draws in the same coordinate space as the caller
+        }
+
+        g.drawImageTransformed(image,
+                               juce::AffineTransform::scale(1.0f / cachedScale)
+                                   .translated((float) cachedBounds.getX(), (float) cachedBounds.getY()));
+    }
+
+private:
+    juce::Image image;
+    juce::Rectangle<int> cachedBounds;
+    juce::int64 cachedState = 0;
+    float cachedScale = 1.0f;
+};
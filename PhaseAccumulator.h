@@ -0,0 +1,68 @@
+// === PhaseAccumulator.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Oscillator phase as an unsigned 32-bit fraction of a cycle.
+ *
+ * Wrapping is integer overflow, so there's no branch and nothing to drift:
+ * a frequency becomes one integer increment, and N samples advance exactly
+ * N increments however long the session runs. Resolution is
+ * sampleRate / 2^32 (about 11 µHz at 48 kHz), which also fixes the
+ * difference between two carriers, e.g. a binaural offset, exactly.
+ */
+struct PhaseAccumulator
+{
+    static constexpr juce::uint32 quarterCycle = 1u << 30;
+
+    juce::uint32 phase = 0;
+
+    /** Advances by one increment and returns the new phase. */
+    juce::uint32 next(juce::uint32 increment) noexcept { return phase += increment; }
+
+    /** Negative frequencies wrap to the equivalent backwards increment. */
+    static juce::uint32 incrementFor(double hz, double sampleRate) noexcept
+    {
+        return (juce::uint32) (juce::int64) std::llround(hz / sampleRate * cycle);
+    }
+
+    static double toRadians(juce::uint32 p) noexcept { return (double) p * (juce::MathConstants<double>::twoPi / cycle); }
+
+private:
+    static constexpr double cycle = 4294967296.0; // 2^32
+};
+
+/**
+ * One cycle of sine, read from a PhaseAccumulator phase: the top bits pick
+ * the entry and the rest interpolate linearly (error around -130 dB).
+ */
+class SineTable
+{
+public:
+    SineTable()
+    {
+        for (int i = 0; i <= size; ++i)
+            table[(size_t) i] = (float) std::sin(juce::MathConstants<double>::twoPi * i / size);
+    }
+
+    float sin(juce::uint32 phase) const noexcept
+    {
+        const auto index = (size_t) (phase >> fractionBits);
+        const float frac = (float) (phase & fractionMask) * (1.0f / (float) (1u << fractionBits));
+        const float a = table[index];
+        return a + frac * (table[index + 1] - a);
+    }
+
+    float cos(juce::uint32 phase) const noexcept { return sin(phase + PhaseAccumulator::quarterCycle); }
+
+private:
+    static constexpr int bits = 12;
+    static constexpr int size = 1 << bits;
+    static constexpr int fractionBits = 32 - bits;
+    static constexpr juce::uint32 fractionMask = (1u << fractionBits) - 1;
+
+    std::array<float, size + 1> table {}; // + guard point for the interpolation
+};
+
+/** Built during static initialisation, so the audio thread only ever reads it. */
+inline const SineTable sineTable;
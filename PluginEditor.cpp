@@ -8,7 +8,7 @@
 CenteredSliderLookAndFeel centeredLook;
 
 PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
-    : juce::AudioProcessorEditor (&p), processor (p)  // FIXED: Added juce:: prefix
+    : juce::AudioProcessorEditor (&p), processor (p), scopeView (p.visualBridge), spectrumView (p)  // FIXED: Added juce:: prefix
 {
     addMouseListener(this, true);
 
@@ -27,9 +27,10 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
         if (!snapModeEnabled)
             return;
 
-        if (!::snapFrequencies.empty()) {
+        const auto& snapFrequencies = processor.getSnapFrequencies();
+        if (!snapFrequencies.empty()) {
             double val = freqSlider.getValue();
-            auto closest = *std::min_element(::snapFrequencies.begin(), ::snapFrequencies.end(),
+            auto closest = *std::min_element(snapFrequencies.begin(), snapFrequencies.end(),
                 [val](float a, float b) {
                     return std::abs(a - val) < std::abs(b - val);
                 });
@@ -49,6 +50,9 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
     snapToggle.setClickingTogglesState(true);
     addAndMakeVisible(snapToggle);
 
+    addAndMakeVisible(scopeView);
+    addAndMakeVisible(spectrumView);
+
     onOffButton.setButtonText ("On");
     onOffButton.setAlpha(0.0f); // Transparent button
     onOffButton.onClick = [this]() { repaint(); }; // Force repaint on toggle
@@ -68,16 +72,17 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
 
     slot0->binauralToggle->onClick = [this]() {
         bool isOn = modifierSlots[0]->binauralToggle->getToggleState();
-        processor.modifierEngine.setModifierEnabled(0, isOn);
+        processor.setModifierEnabled(0, isOn);
     };
     auto* slot1 = modifierSlots[1].get();
     breathRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processor.parameters, "breathRate", *slot1->breathRateSlider);
     breathDepthAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processor.parameters, "breathDepth", *slot1->breathDepthSlider);
+    slot1->breathToggle->setToggleState(processor.isModifierEnabled(1), juce::dontSendNotification);
     slot1->breathToggle->onClick = [this, slot1]() {
         bool isOn = slot1->breathToggle->getToggleState();
-        processor.modifierEngine.setModifierEnabled(1, isOn);
+        processor.setModifierEnabled(1, isOn);
     };
     auto* slot3 = modifierSlots[3].get();
     atmoLevelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -85,15 +90,18 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
 
 
     
-    bool initialBinauralState = processor.modifierEngine.isModifierEnabled(0);
+    bool initialBinauralState = processor.isModifierEnabled(0);
     modifierSlots[0]->setBinauralState(initialBinauralState);
     
     snapToggleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         processor.parameters, "snapOn", snapToggle);
     freqAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processor.parameters, "freeFrequency", freqSlider);
-    if (std::find(::snapFrequencies.begin(), ::snapFrequencies.end(), 0.0f) == ::snapFrequencies.end())
-        ::snapFrequencies.insert(::snapFrequencies.begin(), 0.0f);
+    auto snapFrequencies = processor.getSnapFrequencies();
+    if (std::find(snapFrequencies.begin(), snapFrequencies.end(), 0.0f) == snapFrequencies.end()) {
+        snapFrequencies.insert(snapFrequencies.begin(), 0.0f);
+        processor.setSnapFrequencies(snapFrequencies);
+    }
     freqSlider.setSnapFrequencies(snapFrequencies);
     onOffAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         processor.parameters, "isOn", onOffButton);
@@ -120,18 +128,11 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
     
     
     // === SnapPack Selector ===
+    currentSnapLabel = processor.currentSnapPack;
     snapPackSelector.setButtonText(currentSnapLabel);
     snapPackSelector.onClick = [this]() {
         snapPackMenu.clear();
-        juce::StringArray snapPresets{
-            "Deep Sleep",
-            "Solfeggio (Default)",
-            "Mood Lifter",
-            "Anxiety Buster",
-            "Focus Mode"
-        };
-        if (snapPackManager)
-            snapPresets = snapPackManager->getAllSnapPackNames();
+        juce::StringArray snapPresets = processor.snapLibrary->getAllPackNames();
 
         for (int i = 0; i < snapPresets.size(); ++i)
             snapPackMenu.addItem(i + 1, snapPresets[i]);
@@ -142,11 +143,15 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
         snapPackMenu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&snapPackSelector),
             [this, snapPresets](int result) {
                 if (result == snapPresets.size() + 1) {
-                    if (snapPackManager) {
-                        snapPackManager->setSize(320, 480);
-                        snapPackManager->setTopLeftPosition(getWidth() / 2 - 160, getHeight() / 2 - 240);
-                        snapPackManager->setVisible(true);
-                        snapPackManager->toFront(true);
+                    if (settingsWindow && settingsWindow->snapPackManager) {
+                        auto* manager = settingsWindow->snapPackManager.get();
+                        settingsWindow->setBounds(getLocalBounds());
+                        settingsWindow->setVisible(true);
+                        settingsWindow->toFront(true);
+                        manager->setSize(320, 480);
+                        manager->setTopLeftPosition(getWidth() / 2 - 160, getHeight() / 2 - 240);
+                        manager->setVisible(true);
+                        manager->toFront(true);
                     }
                 } else if (result > 0 && result <= snapPresets.size()) {
                     currentSnapLabel = snapPresets[result - 1];
@@ -197,8 +202,6 @@ PluginEditor::PluginEditor (SimpleOscAudioProcessor& p)
     getConstrainer()->setFixedAspectRatio(1.0);
     
     processor.parameters.addParameterListener("snapOn", this);
-    processor.parameters.addParameterListener("binauralOffset", this);
-    processor.parameters.addParameterListener("binauralWidth", this);
 
 }
 
@@ -206,8 +209,6 @@ PluginEditor::~PluginEditor() {
     stopTimer();
     settingsWindow = nullptr;
     processor.parameters.removeParameterListener("snapOn", this);
-    processor.parameters.removeParameterListener("binauralOffset", this);
-    processor.parameters.removeParameterListener("binauralWidth", this);
     if (settingsWindow)
     {
         settingsWindow->onRangeSelected = nullptr;
@@ -216,18 +217,11 @@ PluginEditor::~PluginEditor() {
 }
 
 void PluginEditor::applySnapPreset(const juce::String& name) {
-    std::vector<float> newList;
-
-    if (snapPresets.count(name) > 0) {
-        newList = snapPresets[name];
-    } else if (snapPackManager) {
-        const auto& userList = snapPackManager->getUserPack(name);
-        newList = userList; // returns empty vector if not found
-    }
-
-    if (!newList.empty()) {
-        ::snapFrequencies = newList;
-        freqSlider.setSnapFrequencies(::snapFrequencies);
+    // Built-in and user packs both come from the shared SnapLibrary
+    if (processor.selectSnapPack(name)) {
+        currentSnapLabel = name;
+        snapPackSelector.setButtonText(currentSnapLabel);
+        freqSlider.setSnapFrequencies(processor.getSnapFrequencies());
         freqSlider.repaint();
     }
 }
@@ -242,7 +236,14 @@ void PluginEditor::timerCallback()
         gradientRotation -= 360.0f;
     
     updateBackgroundParticles();
-    repaint(); // Repaint the whole component
+    scopeView.update();
+    spectrumView.update();
+
+    // The background animates everywhere but under the analyser, which repaints at its own rate
+    juce::RectangleList<int> animated(getLocalBounds());
+    animated.subtract(spectrumView.getBounds());
+    for (const auto& area : animated)
+        repaint(area);
 }
 
 void PluginEditor::initializeBackgroundParticles()
@@ -409,6 +410,18 @@ void PluginEditor::paintMeditativeBackground(juce::Graphics& g)
 void PluginEditor::paint (juce::Graphics& g)
 {
     paintMeditativeBackground(g);
+
+    bool isOn = processor.parameters.getRawParameterValue("isOn")->load() > 0.5f;
+
+    // Everything on top of the animated background only changes on resize or
+    // when the power/snap state flips, so it's rendered once and blitted per frame
+    juce::int64 chromeState = (isOn ? 1 : 0) | (snapModeEnabled ? 2 : 0);
+    chromeLayer.draw(g, getLocalBounds(), chromeState,
+                     [this, isOn](juce::Graphics& lg) { paintChrome(lg, isOn); });
+}
+
+void PluginEditor::paintChrome(juce::Graphics& g, bool isOn)
+{
     //Drop Shadow
     juce::DropShadow shadow(juce::Colours::black.withAlpha(0.5f), 8, {2, 2});
     shadow.drawForRectangle(g, carvedArea);
@@ -471,8 +484,6 @@ void PluginEditor::paint (juce::Graphics& g)
         g.setColour(outlineColor);
         g.drawRoundedRectangle(block, 6.0f, 1.0f);
     }
-    
-    bool isOn = processor.parameters.getRawParameterValue("isOn")->load() > 0.5f;
 
     // === Power Symbol in TopRowBlock1 ===
     if (isOn) {
@@ -480,20 +491,6 @@ void PluginEditor::paint (juce::Graphics& g)
         g.fillRoundedRectangle(topRowBlock1.reduced(2.0f), 6.0f);
     }
     {
-        auto bounds = topRowBlock1.reduced(12.0f);
-        float baseR = std::min(bounds.getWidth(), bounds.getHeight()) * 0.4f;
-        float r = baseR * 0.75f;  // 75% size
-        float cx = bounds.getCentreX();
-        float cy = bounds.getCentreY();
-
-        // Main arc and notch
-        juce::Path arc, notch;
-        arc.addCentredArc(cx, cy, r, r, 0.0f,
-                          juce::MathConstants<float>::pi * 0.25f,
-                          juce::MathConstants<float>::pi * 1.75f, true);
-        notch.startNewSubPath(cx, cy - r);
-        notch.lineTo(cx, cy - r * 0.5f);
-
         juce::Colour powerColor = isOn ? juce::Colours::white : juce::Colours::red;
 
         // Optional subtle glow when OFF
@@ -501,14 +498,14 @@ void PluginEditor::paint (juce::Graphics& g)
         {
             juce::Colour glowColor = juce::Colours::red.withAlpha(0.07f);
             g.setColour(glowColor);
-            g.strokePath(arc, juce::PathStrokeType(6.0f));   // fat glow layer
-            g.strokePath(notch, juce::PathStrokeType(6.0f));
+            g.strokePath(powerArcPath, juce::PathStrokeType(6.0f));   // fat glow layer
+            g.strokePath(powerNotchPath, juce::PathStrokeType(6.0f));
         }
 
         // Actual symbol lines
         g.setColour(powerColor);
-        g.strokePath(arc, juce::PathStrokeType(2.5f));
-        g.strokePath(notch, juce::PathStrokeType(2.5f));
+        g.strokePath(powerArcPath, juce::PathStrokeType(2.5f));
+        g.strokePath(powerNotchPath, juce::PathStrokeType(2.5f));
     }
 
     if (snapModeEnabled)
@@ -518,22 +515,44 @@ void PluginEditor::paint (juce::Graphics& g)
     }
     
     // === Draw Donut Cog Icon with stroked ring ===
+    g.setColour(juce::Colours::aqua);
+    g.strokePath(cogRingPath, juce::PathStrokeType(3.0f));
+    g.fillPath(cogTeethPath);
+}
+
+void PluginEditor::buildIconPaths()
+{
+    // === Power Symbol ===
     {
-        auto area = topRowBlock3.reduced(12.0f);
-        juce::Path cog;
+        auto bounds = topRowBlock1.reduced(12.0f);
+        float baseR = std::min(bounds.getWidth(), bounds.getHeight()) * 0.4f;
+        float r = baseR * 0.75f;  // 75% size
+        float cx = bounds.getCentreX();
+        float cy = bounds.getCentreY();
 
+        // Main arc and notch
+        powerArcPath.clear();
+        powerNotchPath.clear();
+        powerArcPath.addCentredArc(cx, cy, r, r, 0.0f,
+                                   juce::MathConstants<float>::pi * 0.25f,
+                                   juce::MathConstants<float>::pi * 1.75f, true);
+        powerNotchPath.startNewSubPath(cx, cy - r);
+        powerNotchPath.lineTo(cx, cy - r * 0.5f);
+    }
+
+    // === Donut Cog ===
+    {
+        auto area = topRowBlock3.reduced(12.0f);
         float cx = area.getCentreX();
         float cy = area.getCentreY();
         float ringRadius = 9.0f;
-        float ringThickness = 3.0f;
 
-        // Draw the ring (donut shape using stroke)
-        juce::Path ring;
-        ring.addCentredArc(cx, cy, ringRadius, ringRadius, 0.0f, 0.0f, juce::MathConstants<float>::twoPi, true);
-        g.setColour(juce::Colours::aqua);
-        g.strokePath(ring, juce::PathStrokeType(ringThickness));
+        // The ring (donut shape, stroked at paint time)
+        cogRingPath.clear();
+        cogRingPath.addCentredArc(cx, cy, ringRadius, ringRadius, 0.0f, 0.0f, juce::MathConstants<float>::twoPi, true);
 
-        // Draw gear teeth
+        // Gear teeth
+        cogTeethPath.clear();
         for (int i = 0; i < 8; ++i) {
             float angle = juce::MathConstants<float>::twoPi * i / 8.0f;
             float bx = std::cos(angle);
@@ -544,12 +563,9 @@ void PluginEditor::paint (juce::Graphics& g)
                                       .translated(cx + bx * (ringRadius + 2),
                                                   cy + by * (ringRadius + 2));
             tooth.addRectangle(-1.0f, -3.0f, 2.0f, 6.0f);  // small vertical rectangle
-            cog.addPath(tooth, t);
+            cogTeethPath.addPath(tooth, t);
         }
-
-        g.fillPath(cog);
     }
-
 }
 
 
@@ -692,6 +708,8 @@ void PluginEditor::resized()
         modBlockH
     );
 
+    buildIconPaths();
+    chromeLayer.invalidate();
     
     auto layoutArea = carvedArea;
     snapToggle.setBounds(topRowBlock2.reduced(8).toNearestInt());
@@ -727,6 +745,12 @@ void PluginEditor::resized()
     // Volume slider gets its bounds in topRowBlock4
     volumeSlider.setBounds(topRowBlock4.reduced(10).toNearestInt());
     
+    // Scope + meters live in the margin below the carved panel, the spectrum in the one above
+    scopeView.setBounds(carvedArea.getX(), carvedArea.getBottom() + 8,
+                        carvedArea.getWidth(), juce::jmax(0, bounds.getBottom() - carvedArea.getBottom() - 16));
+    spectrumView.setBounds(carvedArea.getX(), bounds.getY() + 8,
+                           carvedArea.getWidth(), juce::jmax(0, carvedArea.getY() - bounds.getY() - 16));
+
     snapPackSelector.setBounds(midRowBlock1.reduced(4).toNearestInt());
     rangeSelector.setBounds(midRowBlock2.reduced(4).toNearestInt());
 
@@ -734,15 +758,10 @@ void PluginEditor::resized()
 
 void PluginEditor::parameterChanged(const juce::String& paramID, float newValue)
 {
-    // ✅ This runs for offset/width changes
-    if (paramID == "binauralOffset" || paramID == "binauralWidth")
-    {
-        processor.parameterChanged(paramID, newValue); // 💥 forward to audio processor
-    }
-
     if (paramID == "snapOn")
     {
         snapModeEnabled = newValue > 0.5f;
+        const auto& snapFrequencies = processor.getSnapFrequencies();
         freqSlider.setSnapMode(snapModeEnabled);
         freqSlider.setSnapFrequencies(snapFrequencies);
 
@@ -785,6 +804,7 @@ void PluginEditor::setFrequencyRange(double min, double max) {
     freqSlider.freqMin = min;
     freqSlider.freqMax = max;
 
+    const auto& snapFrequencies = processor.getSnapFrequencies();
     if (snapModeEnabled && !snapFrequencies.empty()) {
         double snapMin = *std::min_element(snapFrequencies.begin(), snapFrequencies.end());
         double snapMax = *std::max_element(snapFrequencies.begin(), snapFrequencies.end());
@@ -5,6 +5,9 @@
 #include "ModifierSlot.h"
 #include "SettingsWindow.h"
 #include "FreeSlider.h"
+#include "PaintCache.h"
+#include "ScopeView.h"
+#include "SpectrumView.h"
 #include <random>    // Add this for std::mt19937
 #include <fstream>
 
@@ -36,6 +39,13 @@ private:
     juce::Rectangle<float> sliderBlock;
     juce::Rectangle<float> modBlock1, modBlock2, modBlock3, modBlock4;
 
+    // Icon paths are rebuilt in resized(), the static chrome is cached as one layer
+    juce::Path powerArcPath, powerNotchPath;
+    juce::Path cogRingPath, cogTeethPath;
+    CachedLayer chromeLayer;
+    void buildIconPaths();
+    void paintChrome(juce::Graphics& g, bool isOn);
+
     bool snapModeEnabled = false;
 
     juce::ToggleButton snapToggle;
@@ -44,13 +54,8 @@ private:
     juce::ToggleButton onOffButton;
     juce::TextButton settingsButton { "⚙" };
     std::array<std::unique_ptr<ModifierSlot>, 4> modifierSlots;
-    std::map<juce::String, std::vector<float>> snapPresets = {
-        {"Deep Sleep",      {0.0f, 40.0f, 50.0f, 62.0f, 108.0f, 120.0f, 136.1f, 174.0f, 285.0f}},
-        {"Solfeggio (Default)", {0.0f, 174.0f, 285.0f, 396.0f, 417.0f, 528.0f, 639.0f, 741.0f, 852.0f, 963.0f}},
-        {"Mood Lifter",      {0.0f, 136.1f, 432.0f, 528.0f, 852.0f, 888.0f, 963.0f}},
-        {"Anxiety Buster",   {0.0f, 111.0f, 136.1f, 396.0f, 417.0f, 444.0f, 528.0f, 639.0f, 741.0f}},
-        {"Focus Mode",       {0.0f, 40.0f, 111.0f, 144.72f, 396.0f, 417.0f, 528.0f, 888.0f, 963.0f}},
-    };
+    ScopeView scopeView;
+    SpectrumView spectrumView;
     juce::TextButton snapPackSelector;
     juce::TextButton rangeSelector;
     juce::PopupMenu snapPackMenu;
@@ -58,7 +63,6 @@ private:
     juce::String currentSnapLabel { "Solfeggio (Default)" };
     juce::String currentRangeLabel { "0-2222 Hz (Default)" };
 
-    std::unique_ptr<SnapPackManager> snapPackManager;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> snapToggleAttachment;
     std::unique_ptr<SettingsWindow> settingsWindow;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> freqAttachment;
@@ -2,38 +2,38 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "FreeMode.h"
+#include "SnapMode.h"
+#include "SweepMode.h"
 
 SimpleOscAudioProcessor::SimpleOscAudioProcessor()
     : AudioProcessor (BusesProperties().withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
       parameters (*this, nullptr, juce::Identifier ("APVTS"), createParameterLayout())
 {
+    // Values reach the engine through syncParameters(); the listener only switches modes
     parameters.addParameterListener("snapOn", this);
-    parameters.addParameterListener("freeFrequency", this);
-    parameters.addParameterListener("isOn", this);
-    parameters.addParameterListener("breathRate", this);
-    parameters.addParameterListener("breathDepth", this);
+    parameters.addParameterListener("sweepOn", this);
 
+    // Nothing is playing yet, so the defaults go straight to the engine
+    for (int i = 0; i < 4; ++i)
+        requestedModifierEnabled[(size_t) i] = modifierEngine.isModifierEnabled(i);
+    requestedModifierEnabled[0] = false; // Binaural off by default
+    requestedModifierEnabled[2] = false; // Harmonics off by default
+    for (int i = 0; i < 4; ++i)
+        modifierEngine.setModifierEnabled(i, requestedModifierEnabled[(size_t) i]);
+    audioSnapFrequencies = snapFrequencies;
 
-    for (int i = 2; i <= 9; ++i) {
-        juce::String id = "harmonic" + juce::String(i);
-        parameters.addParameterListener(id, this);
-    }
-    parameters.addParameterListener("harmonicLevel", this);
-    parameters.addParameterListener("atmoType", this);
-    parameters.addParameterListener("atmoLevel", this);
-    
     switchMode(0);
-    
-    
 }
 
 SimpleOscAudioProcessor::~SimpleOscAudioProcessor()
 {
-    for (int i = 2; i <= 9; ++i) {
-        juce::String id = "harmonic" + juce::String(i);
-        parameters.removeParameterListener(id, this);
-    }
-    parameters.removeParameterListener("harmonicLevel", this);
+    cancelPendingUpdate();
+
+    // Hand anything still queued to the release pool so it gets freed
+    applyCommands();
+
+    parameters.removeParameterListener("snapOn", this);
+    parameters.removeParameterListener("sweepOn", this);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleOscAudioProcessor::createParameterLayout()
@@ -50,6 +50,27 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleOscAudioProcessor::cre
         "binauralOffset", "Binaural Offset", -15.0f, 15.0f, 0.0f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "binauralWidth", "Binaural Width", 0.0f, 1.0f, 1.0f));
+    for (int i = 0; i < BinauralLayers::numLayers; ++i) {
+        const juce::String id = "binauralLayer" + juce::String(BinauralLayers::firstLayerNumber + i);
+        const juce::String name = "Binaural Layer " + juce::String(BinauralLayers::firstLayerNumber + i);
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            id + "Carrier", name + " Carrier", juce::NormalisableRange<float>(20.0f, 1000.0f, 0.0f, 0.5f), BinauralLayers::defaultCarrier));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            id + "Offset", name + " Offset", -15.0f, 15.0f, BinauralLayers::defaultOffsets[(size_t) i]));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(id + "Width", name + " Width", 0.0f, 1.0f, 1.0f));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(id + "Level", name + " Level", 0.0f, 1.0f, 0.0f));
+    }
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "glideTime", "Glide Time", juce::NormalisableRange<float>(0.0f, 10.0f, 0.0f, 0.3f), 0.05f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "glideCurve", "Glide Curve", juce::StringArray { "Linear", "Exponential" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterBool>("sweepOn", "Sweep On", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "sweepTime", "Sweep Time", juce::NormalisableRange<float>(1.0f, 600.0f, 0.0f, 0.3f), 30.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "sweepCurve", "Sweep Curve", juce::StringArray { "Linear", "Exponential" }, 1));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "sweepSource", "Sweep Source", juce::StringArray { "Range", "Snap Pack" }, 0));
     params.push_back(std::make_unique<juce::AudioParameterFloat>("breathRate", "Breath Rate", 0.01f, 1.0f, 0.25f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>("breathDepth", "Breath Depth", 0.0f, 1.0f, 0.5f));
 
@@ -66,6 +87,17 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleOscAudioProcessor::cre
         juce::String id = "harmonic" + juce::String(i);
         params.push_back(std::make_unique<juce::AudioParameterBool>(id, id, false));
     }
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "harmonicEngine", "Harmonic Engine", juce::StringArray { "Partials", "Spectral", "Waveshaper" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        "harmonicCount", "Harmonic Count", SpectralHarmonics::minPartials, SpectralHarmonics::maxPartials, 64));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("spectralTilt", "Spectral Tilt", -12.0f, 6.0f, -6.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("spectralOddEven", "Spectral Odd/Even", -1.0f, 1.0f, 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "spectralFormantFrequency", "Spectral Formant Frequency",
+        juce::NormalisableRange<float>(100.0f, 8000.0f, 0.0f, 0.3f), 1000.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "spectralFormantGain", "Spectral Formant Gain", 0.0f, 24.0f, 0.0f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "atmoType", "Atmosphere Type",
         juce::NormalisableRange<float>(0.0f, 7.0f, 1.0f), 0.0f));  // 0=Off, 1=White, etc.
@@ -82,56 +114,509 @@ void SimpleOscAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
     this->sampleRate = sampleRate;
     if (currentMode)
         currentMode->prepare(sampleRate);
+    if (incomingMode)
+        incomingMode->prepare(sampleRate);
+
+    const int numChannels = getTotalNumOutputChannels();
+    modeScratch.setSize(numChannels, samplesPerBlock);
+    crossfadeLength = juce::jmax(1, (int) (sampleRate * modeCrossfadeSeconds));
     modifierEngine.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
-    modifierEngine.setModifierEnabled(0, false); // Ensure Binaural is active
-    modifierEngine.setModifierEnabled(2, false); // Harmonics off by default
+    visualBridge.prepare(sampleRate, samplesPerBlock);
+    recallGain.reset(sampleRate, recallFadeSeconds);
+    volumeSmoother.reset(sampleRate, 0.02);
+    volumeSmoother.setCurrentAndTargetValue(parameters.getRawParameterValue("volume")->load());
+    oscillatorFade.reset(sampleRate, 0.02);
+    oscillatorFade.setCurrentAndTargetValue(parameters.getRawParameterValue("isOn")->load() > 0.5f ? 1.0f : 0.0f);
+    oscillatorRamp.assign((size_t) juce::jmax(1, samplesPerBlock), 0.0f);
+
+    // Not playing, so the engine can be brought up to date directly, recall included
+    const auto sequence = recallSequence.load();
+    syncParameters();
+    if ((sequence & 1) == 0)
+        appliedRecallSequence = sequence;
 }
 
 void SimpleOscAudioProcessor::releaseResources() {}
 
+bool SimpleOscAudioProcessor::canFuse(int numChannels) const
+{
+    return incomingMode == nullptr && currentMode != nullptr && currentMode->canRenderChunks()
+        && (numChannels == 1 || numChannels == 2) && modifierEngine.breathFollowsSources();
+}
+
+template <size_t... Flags>
+constexpr std::array<SimpleOscAudioProcessor::FusedKernel, sizeof...(Flags)>
+SimpleOscAudioProcessor::makeFusedKernels(std::index_sequence<Flags...>)
+{
+    return { &SimpleOscAudioProcessor::renderFused<(Flags & 1) != 0, (Flags & 2) != 0, (Flags & 4) != 0, (Flags & 8) != 0>... };
+}
+
+template <bool Binaural, bool Harmonics, bool Atmosphere, bool Breath>
+void SimpleOscAudioProcessor::renderFused(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    float* outL = buffer.getWritePointer(0, startSample);
+    float* outR = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1, startSample) : nullptr;
+
+    for (int offset = 0; offset < numSamples; offset += fusedChunkSize) {
+        const int n = juce::jmin(fusedChunkSize, numSamples - offset);
+        float* left = fusedLeft.data();
+        float* right = fusedRight.data();
+        float* centre = fusedCentre.data();
+        float* gain = fusedGain.data();
+
+        // Carrier and its quadrature, unless switched off and faded out; the harmonics come
+        // first, while left is still the bare carrier for them to shape
+        const bool oscillator = !oscillatorFade.isSettled() || oscillatorFade.getTargetValue() > 0.0f;
+        if (oscillator) {
+            currentMode->renderChunk(left, Binaural ? right : nullptr, n);
+        } else {
+            juce::FloatVectorOperations::clear(left, n);
+            if constexpr (Binaural)
+                juce::FloatVectorOperations::clear(right, n);
+        }
+
+        if constexpr (Harmonics || Atmosphere)
+            juce::FloatVectorOperations::clear(centre, n);
+        if constexpr (Harmonics)
+            if (oscillator)
+                modifierEngine.addHarmonics(centre, n, currentMode->getFrequency(), left);
+
+        // The two ears, then width on them alone (the centred sources join below)
+        if constexpr (Binaural) {
+            modifierEngine.renderBinauralPair(left, right, n);
+            if (modifierEngine.isWidthActive())
+                modifierEngine.applyWidth(left, right, n);
+        }
+
+        // The on/off fade takes the carrier and harmonics; the layers and atmosphere play on
+        if (oscillatorFade.fill(fusedOscillator.data(), n)) {
+            juce::FloatVectorOperations::multiply(left, fusedOscillator.data(), n);
+            if constexpr (Binaural)
+                juce::FloatVectorOperations::multiply(right, fusedOscillator.data(), n);
+            if constexpr (Harmonics)
+                juce::FloatVectorOperations::multiply(centre, fusedOscillator.data(), n);
+        }
+
+        if constexpr (Binaural)
+            if (modifierEngine.areBinauralLayersActive())
+                modifierEngine.addBinauralLayers(left, right, n);
+        if constexpr (Atmosphere)
+            modifierEngine.addAtmosphere(centre, n);
+
+        // Breath and volume fold into one gain
+        const bool volumeRamping = volumeSmoother.fill(fusedVolume.data(), n);
+        if constexpr (Breath) {
+            modifierEngine.fillBreathGain(gain, n);
+            if (volumeRamping)
+                juce::FloatVectorOperations::multiply(gain, fusedVolume.data(), n);
+            else
+                juce::FloatVectorOperations::multiply(gain, volumeSmoother.getTargetValue(), n);
+        } else {
+            if (volumeRamping)
+                std::copy(fusedVolume.begin(), fusedVolume.begin() + n, gain);
+            else
+                juce::FloatVectorOperations::fill(gain, volumeSmoother.getTargetValue(), n);
+        }
+
+        // The one write to the output
+        float* l = outL + offset;
+        if constexpr (Binaural) {
+            float* r = outR + offset;
+            for (int i = 0; i < n; ++i) {
+                const float c = (Harmonics || Atmosphere) ? centre[i] : 0.0f;
+                l[i] = (left[i] + c) * gain[i];
+                r[i] = (right[i] + c) * gain[i];
+            }
+        } else if (outR != nullptr) {
+            float* r = outR + offset;
+            for (int i = 0; i < n; ++i) {
+                const float c = (Harmonics || Atmosphere) ? centre[i] : 0.0f;
+                l[i] = r[i] = (left[i] + c) * gain[i];
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                const float c = (Harmonics || Atmosphere) ? centre[i] : 0.0f;
+                l[i] = (left[i] + c) * gain[i];
+            }
+        }
+    }
+}
+
 void SimpleOscAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    // Flush-to-zero for everything below: decaying filter and smoother tails stay cheap
+    juce::ScopedNoDenormals noDenormals;
+
     buffer.clear();
 
-    bool isOn = parameters.getRawParameterValue("isOn")->load() > 0.5f;
-    if (currentMode)
-        currentMode->processBlock(buffer, midi, isOn);
+    applyCommands();
+
+    // A recall (or another one, mid fade-in) holds the engine where it is until it's faded out
+    const bool recallPending = recallSequence.load() != appliedRecallSequence;
+    if (recallPending && recallPhase != RecallPhase::fadingOut) {
+        recallPhase = RecallPhase::fadingOut;
+        recallGain.setTargetValue(0.0f);
+    }
+
+    // Parameters are read once per block. Hosts set every automation value before calling
+    // processBlock, so there is nothing finer to pick up; a step from one block to the next is
+    // ramped by the smoothers (volume, glide, the modifiers' gains) rather than landing at once.
+    if (!recallPending)
+        syncParameters();
+
+    // Switching off fades the carrier and harmonics out; the binaural layers and atmosphere
+    // are sources of their own and keep playing. Once nothing is left sounding (or the volume
+    // has settled at 0) nothing renders: the block stays cleared and the engine is parked.
+    const bool isOn = parameters.getRawParameterValue("isOn")->load() > 0.5f;
+    oscillatorFade.setTargetValue(isOn ? 1.0f : 0.0f);
+    volumeSmoother.setTargetValue(parameters.getRawParameterValue("volume")->load());
+
+    // Scratch is sized for the prepared block size; hosts that send more get it in pieces
+    const int numSamples = buffer.getNumSamples();
+    const int maxPiece = juce::jmax(1, modeScratch.getNumSamples());
+    bool rendered = false;
+
+    for (int start = 0; start < numSamples;) {
+        const int length = juce::jmin(numSamples - start, maxPiece);
+        const bool oscillator = !oscillatorFade.isSettled() || oscillatorFade.getTargetValue() > 0.0f;
+        const bool muted = volumeSmoother.isSettled() && volumeSmoother.getTargetValue() == 0.0f;
+        // A mode crossfade always runs to the end, so a switch queued behind it isn't held up
+        const bool parked = incomingMode == nullptr
+                         && (muted || (!oscillator && !modifierEngine.isAtmosphereActive()
+                                       && !modifierEngine.areBinauralLayersActive()));
+        rendered = rendered || !parked;
+
+        if (parked) {
+            // Silent: already cleared. Breath only shapes the sources, so it just keeps time.
+            modifierEngine.skipBreath(length);
+        } else if (canFuse(buffer.getNumChannels())) {
+            static constexpr auto kernels = makeFusedKernels(std::make_index_sequence<16>());
+            const size_t flags = (modifierEngine.isModifierEnabled(0) && buffer.getNumChannels() == 2 ? 1u : 0u)
+                               | (modifierEngine.isHarmonicsActive() ? 2u : 0u)
+                               | (modifierEngine.isAtmosphereActive() ? 4u : 0u)
+                               | (modifierEngine.isBreathActive() ? 8u : 0u);
+            (this->*kernels[flags])(buffer, start, length);
+        } else {
+            juce::AudioBuffer<float> piece(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+            ModifierContext context { leadFrequency(), oscillator };
+            context.carrierIsBlend = incomingMode != nullptr;
+            if (oscillatorFade.fill(oscillatorRamp.data(), length))
+                context.oscillatorGain = oscillatorRamp.data();
+
+            renderModes(piece, midi, oscillator);
+            modifierEngine.process(piece, context);
+            volumeSmoother.applyGain(piece, 0, length);
+        }
+
+        start += length;
+    }
+
+    if (recallPhase != RecallPhase::idle)
+        processRecall(buffer);
 
-    modifierEngine.process(buffer);
+    // Snap and Sweep don't play freeFrequency, so the markers follow what the modes actually render
+    const bool sounding = !oscillatorFade.isSettled() || oscillatorFade.getTargetValue() > 0.0f;
+    visualBridge.setLeadFrequency(sounding ? leadFrequency() : 0.0f);
+
+    // One silent block lets the displays settle; after that an idle instance skips them too
+    if (rendered || !visualsSilent)
+        visualBridge.push(buffer);
+    visualsSilent = !rendered;
+}
 
-    float volume = parameters.getRawParameterValue("volume")->load();
-    buffer.applyGain(volume);
+void SimpleOscAudioProcessor::parameterChanged (const juce::String& paramID, float)
+{
+    // Values reach the engine through syncParameters(); only a mode switch needs the message thread
+    if (paramID == "snapOn" || paramID == "sweepOn")
+        triggerAsyncUpdate();
 }
 
-void SimpleOscAudioProcessor::parameterChanged (const juce::String& paramID, float newValue)
+void SimpleOscAudioProcessor::syncParameters()
 {
+    parameterSource.read(engineParameters);
+
     if (currentMode)
-        currentMode->parameterChanged(paramID, newValue);
-    modifierEngine.parameterChanged(paramID, newValue);
+        currentMode->setParameters(engineParameters);
+    if (incomingMode)
+        incomingMode->setParameters(engineParameters);
+    modifierEngine.setParameters(engineParameters);
 }
 
 void SimpleOscAudioProcessor::switchMode(int newMode)
 {
+    std::unique_ptr<OscMode> mode;
     if (newMode == 0)
-        currentMode = std::make_unique<FreeMode>(this); // pass 'this'
+        mode = std::make_unique<FreeMode>(this); // pass 'this'
+    else if (newMode == 1)
+        mode = std::make_unique<SnapMode>(this);
+    else if (newMode == 2)
+        mode = std::make_unique<SweepMode>(this);
+
+    if (mode == nullptr)
+        return;
+
+    // Fully set up here, so the audio thread only has to swap the pointer. Nothing else can
+    // see the mode yet; once queued it's the audio thread's.
+    EngineParameters params;
+    parameterSource.read(params);
+    mode->prepare(sampleRate);
+    mode->setParameters(params);
+
+    if (currentMode == nullptr) {
+        currentMode = std::move(mode); // constructor: no audio yet
+        lastMode = newMode;
+        return;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommand::swapMode;
+    command.mode = mode.get();
+    if (commandQueue.push(command)) {
+        mode.release();
+        lastMode = newMode;
+    } else {
+        // lastMode still names the playing mode, so the retry switches again
+        DBG("Command queue full, mode switch deferred");
+        triggerAsyncUpdate();
+    }
+}
+
+int SimpleOscAudioProcessor::modeForParameters() const
+{
+    if (parameters.getRawParameterValue("sweepOn")->load() > 0.5f)
+        return 2;
+    return parameters.getRawParameterValue("snapOn")->load() > 0.5f ? 1 : 0;
+}
+
+void SimpleOscAudioProcessor::handleAsyncUpdate()
+{
+    const int mode = modeForParameters();
+    if (mode != lastMode)
+        switchMode(mode);
+    if (snapFrequenciesUnpublished)
+        publishSnapFrequencies();
+}
+
+void SimpleOscAudioProcessor::setModifierEnabled(int slotIndex, bool enable)
+{
+    if (slotIndex < 0 || slotIndex >= (int) requestedModifierEnabled.size())
+        return;
+
+    requestedModifierEnabled[(size_t) slotIndex] = enable;
+
+    AudioCommand command;
+    command.type = AudioCommand::setModifierEnabled;
+    command.slot = slotIndex;
+    command.enabled = enable;
+    if (!commandQueue.push(command))
+        DBG("Command queue full, modifier " << slotIndex << " change dropped");
+}
+
+void SimpleOscAudioProcessor::setModifierOrder(const ModifierEngine::Order& order)
+{
+    if (!ModifierEngine::isValidOrder(order))
+        return;
+
+    requestedModifierOrder = order;
+
+    AudioCommand command;
+    command.type = AudioCommand::setModifierOrder;
+    command.order = order;
+    if (!commandQueue.push(command))
+        DBG("Command queue full, modifier order change dropped");
+}
+
+void SimpleOscAudioProcessor::setSnapFrequencies(std::vector<float> frequencies)
+{
+    snapFrequencies = std::move(frequencies);
+    publishSnapFrequencies();
+}
+
+void SimpleOscAudioProcessor::publishSnapFrequencies()
+{
+    auto frequencies = std::make_unique<std::vector<float>>(snapFrequencies);
+
+    AudioCommand command;
+    command.type = AudioCommand::swapSnapFrequencies;
+    command.frequencies = frequencies.get();
+    snapFrequenciesUnpublished = !commandQueue.push(command);
+    if (snapFrequenciesUnpublished) {
+        // The list stays current here; the retry sends whatever it is by then
+        DBG("Command queue full, snap list update deferred");
+        triggerAsyncUpdate();
+    } else {
+        frequencies.release();
+    }
+}
+
+void SimpleOscAudioProcessor::applyCommands()
+{
+    commandQueue.drain([this](const AudioCommand& command) {
+        switch (command.type) {
+            case AudioCommand::setModifierEnabled:
+                modifierEngine.setModifierEnabled(command.slot, command.enabled);
+                return true;
+
+            case AudioCommand::setModifierOrder:
+                modifierEngine.setOrder(command.order);
+                return true;
+
+            case AudioCommand::swapMode:
+                // A switch that's still fading finishes first; cutting it short would click.
+                // The commands behind this one wait with it, for at most one crossfade.
+                if (!releasePool.hasSpace() || incomingMode != nullptr)
+                    return false; // try again next block
+                if (currentMode == nullptr || modeScratch.getNumSamples() == 0) {
+                    releasePool.retire(currentMode.release());
+                    currentMode.reset(command.mode);
+                    return true;
+                }
+                incomingMode.reset(command.mode);
+                incomingMode->setPhase(currentMode->getPhase());
+                crossfadeRemaining = crossfadeLength;
+                return true;
+
+            case AudioCommand::swapSnapFrequencies:
+                if (!releasePool.hasSpace())
+                    return false;
+                // The command's vector leaves holding the old list
+                std::swap(audioSnapFrequencies, *command.frequencies);
+                releasePool.retire(command.frequencies);
+                ++audioSnapVersion;
+                return true;
+        }
+        return true;
+    });
+}
+
+void SimpleOscAudioProcessor::renderModes(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi, bool isOn)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
 
     if (currentMode)
-    {
-        currentMode->prepare(sampleRate);
-        parameterChanged("freeFrequency", parameters.getRawParameterValue("freeFrequency")->load());
+        currentMode->processBlock(buffer, midi, isOn);
+
+    if (incomingMode) {
+        juce::AudioBuffer<float> incoming(modeScratch.getArrayOfWritePointers(), numChannels, numSamples);
+        incomingMode->processBlock(incoming, midi, isOn);
+
+        // Phases are aligned, so a linear fade doesn't dip
+        const int fadeSamples = juce::jmin(numSamples, crossfadeRemaining);
+        const float startGain = 1.0f - (float) crossfadeRemaining / (float) crossfadeLength;
+        const float endGain = 1.0f - (float) (crossfadeRemaining - fadeSamples) / (float) crossfadeLength;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            if (fadeSamples > 0) {
+                buffer.applyGainRamp(ch, 0, fadeSamples, 1.0f - startGain, 1.0f - endGain);
+                buffer.addFromWithRamp(ch, 0, incoming.getReadPointer(ch), fadeSamples, startGain, endGain);
+            }
+            if (numSamples > fadeSamples)
+                buffer.copyFrom(ch, fadeSamples, incoming, ch, fadeSamples, numSamples - fadeSamples);
+        }
+
+        crossfadeRemaining -= fadeSamples;
+        if (crossfadeRemaining == 0 && releasePool.hasSpace()) {
+            releasePool.retire(currentMode.release());
+            currentMode = std::move(incomingMode);
+        }
     }
 }
 
+float SimpleOscAudioProcessor::leadFrequency() const
+{
+    // Harmonics follow whichever mode is taking over
+    if (incomingMode)
+        return incomingMode->getFrequency();
+    return currentMode ? currentMode->getFrequency() : 0.0f;
+}
+
+bool SimpleOscAudioProcessor::selectSnapPack(const juce::String& name)
+{
+    auto frequencies = snapLibrary->getPack(name);
+    if (frequencies.empty())
+        return false;
+
+    currentSnapPack = name;
+    setSnapFrequencies(std::move(frequencies));
+    return true;
+}
+
 juce::AudioProcessorEditor* SimpleOscAudioProcessor::createEditor()      { return new PluginEditor (*this); }
 bool SimpleOscAudioProcessor::hasEditor() const                          { return true; }
 void SimpleOscAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    if (auto xml = parameters.copyState().createXml()) {
-        copyXmlToBinary(*xml, destData);
-    }
+    PluginState state;
+
+    for (auto* p : getParameters())
+        if (auto* param = dynamic_cast<juce::RangedAudioParameter*>(p))
+            state.parameters.emplace_back(param->paramID, param->convertFrom0to1(param->getValue()));
+
+    // Keep a copy of the active pack so the session still loads where the library doesn't have it
+    state.snapPack = currentSnapPack;
+    state.snapFrequencies = snapFrequencies;
+
+    for (int i = 0; i < 4; ++i)
+        if (isModifierEnabled(i))
+            state.modifierFlags |= (juce::uint8) (1 << i);
+    state.modifierOrder = requestedModifierOrder;
+    state.hasModifierOrder = true;
+
+    state.writeTo(destData);
 }
 void SimpleOscAudioProcessor::setStateInformation(const void* data, int sizeInBytes) {
-    if (auto xmlState = getXmlFromBinary(data, sizeInBytes)) {
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    PluginState state;
+
+    if (!state.readFrom(data, sizeInBytes)) {
+        // Sessions saved before the binary format
+        auto xmlState = getXmlFromBinary(data, sizeInBytes);
+        if (xmlState == nullptr || !state.readLegacyTree(juce::ValueTree::fromXml(*xmlState)))
+            return;
+    }
+
+    applyState(state);
+}
+
+void SimpleOscAudioProcessor::applyState(const PluginState& state)
+{
+    if (state.snapPack.isNotEmpty() && !selectSnapPack(state.snapPack) && !state.snapFrequencies.empty()) {
+        currentSnapPack = state.snapPack;
+        setSnapFrequencies(state.snapFrequencies);
+    }
+
+    if (state.hasModifierFlags)
+        for (int i = 0; i < 4; ++i)
+            setModifierEnabled(i, (state.modifierFlags >> i) & 1);
+    setModifierOrder(state.hasModifierOrder ? state.modifierOrder : ModifierEngine::defaultOrder);
+
+    // Hosts and the editor hear about every value as usual; the engine picks them up together,
+    // behind the recall fade. A snap/sweep change switches mode through the listener as usual.
+    ++recallSequence;
+    for (const auto& [id, value] : state.parameters)
+        if (auto* param = parameters.getParameter(id))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    ++recallSequence;
+}
+
+void SimpleOscAudioProcessor::processRecall(juce::AudioBuffer<float>& buffer)
+{
+    recallGain.applyGain(buffer, buffer.getNumSamples());
+
+    if (recallGain.isSmoothing())
+        return;
+
+    if (recallPhase == RecallPhase::fadingOut) {
+        // Silent now, so the whole recalled state can land at once; hold here while it's still being written
+        const auto sequence = recallSequence.load();
+        if ((sequence & 1) != 0)
+            return;
+
+        syncParameters();
+        appliedRecallSequence = sequence;
+
+        recallPhase = RecallPhase::fadingIn;
+        recallGain.setTargetValue(1.0f);
+    } else {
+        recallPhase = RecallPhase::idle;
     }
 }
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()                   { return new SimpleOscAudioProcessor(); }
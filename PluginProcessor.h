@@ -4,9 +4,14 @@
 #include "OscMode.h"
 #include <memory>
 #include "ModifierEngine.h"
+#include "VisualizationBridge.h"
+#include "SnapLibrary.h"
+#include "PluginState.h"
+#include "AudioCommandQueue.h"
 
 class SimpleOscAudioProcessor  : public juce::AudioProcessor,
-                                 private juce::AudioProcessorValueTreeState::Listener
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private juce::AsyncUpdater
 {
 public:
     SimpleOscAudioProcessor();
@@ -47,15 +52,99 @@ public:
     void parameterChanged(const juce::String& paramID, float newValue) override;
 
 
+    /** Looks the pack up in the shared library and makes it the active snap list. */
+    bool selectSnapPack(const juce::String& name);
+    /** Message thread. This instance's active snap list, as the editor shows it. */
+    const std::vector<float>& getSnapFrequencies() const { return snapFrequencies; }
+    /** Message thread. Replaces the active snap list and sends a copy to the audio thread. */
+    void setSnapFrequencies(std::vector<float> frequencies);
+
+    // Message thread. Enables are queued for the audio thread; reads return the last requested state.
+    void setModifierEnabled(int slotIndex, bool enable);
+    bool isModifierEnabled(int slotIndex) const { return requestedModifierEnabled[(size_t) slotIndex]; }
+    /** Message thread. The order the modifier slots run in; ignored unless it names each slot once. */
+    void setModifierOrder(const ModifierEngine::Order& order);
+    const ModifierEngine::Order& getModifierOrder() const { return requestedModifierOrder; }
+    /** 0 = Free, 1 = Snap, 2 = Sweep. */
+    void switchMode(int newMode);
+
+    /** Audio thread's copy of the snap list, only swapped at block start. */
+    const std::vector<float>& getAudioSnapFrequencies() const { return audioSnapFrequencies; }
+    /** Audio thread. Goes up by one every time that list is swapped. */
+    juce::uint32 getAudioSnapVersion() const { return audioSnapVersion; }
+
     int lastMode = 0;
+    juce::String currentSnapPack { "Solfeggio (Default)" };
+    juce::SharedResourcePointer<SnapLibrary> snapLibrary;
     
     ModifierEngine modifierEngine;
+    VisualizationBridge visualBridge;
 private:
+    BlockSmoother volumeSmoother { 0.5f };   // volume, for everything
+    BlockSmoother oscillatorFade { 1.0f };   // the on switch, for the carrier and harmonics only
+    std::vector<float> oscillatorRamp;       // oscillatorFade per sample, for the chain path
+    bool visualsSilent = false;
+
+    ReleasePool releasePool;
+    AudioCommandQueue commandQueue;
+    std::array<bool, 4> requestedModifierEnabled {};
+    ModifierEngine::Order requestedModifierOrder = ModifierEngine::defaultOrder;
+    std::vector<float> snapFrequencies = { 0.0f, 174.0f, 285.0f, 396.0f, 417.0f, 528.0f, 639.0f, 741.0f, 852.0f, 963.0f }; // message thread, starts as the default pack
+    std::vector<float> audioSnapFrequencies;
+    void publishSnapFrequencies();
+    bool snapFrequenciesUnpublished = false; // queue was full; handleAsyncUpdate() tries again
+    juce::uint32 audioSnapVersion = 0;
+
     std::unique_ptr<OscMode> currentMode;
+
+    // The modes and modifiers belong to the audio thread; it reads their parameters through
+    // parameterSource (IDs resolved on construction) and hands them down in syncParameters()
+    EngineParameters::Source parameterSource { parameters };
+    EngineParameters engineParameters;
+
+    // Mode switches: the incoming mode starts on the outgoing mode's phase and both run
+    // for modeCrossfadeSeconds. Scratch buffers are sized in prepareToPlay.
+    std::unique_ptr<OscMode> incomingMode;
+    int crossfadeLength = 0, crossfadeRemaining = 0;
+    juce::AudioBuffer<float> modeScratch;
+    static constexpr double modeCrossfadeSeconds = 0.03;
     double sampleRate = 44100.0;
 
-    void switchMode(int newMode);
+    // Preset recall: applyState bumps recallSequence before and after writing the parameters
+    // (so it's odd while they're half written). Once the audio thread sees it move, it stops
+    // syncing, fades out, waits for an even count, syncs once at silence and fades back in.
+    // Edits made during the fade are in the parameters by then, so they land with the recall.
+    enum class RecallPhase { idle, fadingOut, fadingIn };
+
+    std::atomic<juce::uint32> recallSequence { 0 };
+    juce::uint32 appliedRecallSequence = 0; // audio thread
+    RecallPhase recallPhase = RecallPhase::idle;
+    juce::SmoothedValue<float> recallGain { 1.0f };
+    static constexpr double recallFadeSeconds = 0.01;
+
     void initializeModifiers();
+    void applyCommands();
+    void syncParameters();
+    int modeForParameters() const;
+    void handleAsyncUpdate() override;
+    void renderModes(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi, bool isOn);
+    float leadFrequency() const;
+
+    // Fused path: carrier, width, harmonics, atmosphere, breath and volume in one pass per
+    // chunk, specialised per combination of active stages. Used whenever a single chunk-capable
+    // mode is playing into mono or stereo and the slot order matches the fused stage order;
+    // everything else goes through renderModes + the chain.
+    using FusedKernel = void (SimpleOscAudioProcessor::*)(juce::AudioBuffer<float>&, int, int);
+    template <bool Binaural, bool Harmonics, bool Atmosphere, bool Breath>
+    void renderFused(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    template <size_t... Flags>
+    static constexpr std::array<FusedKernel, sizeof...(Flags)> makeFusedKernels(std::index_sequence<Flags...>);
+    bool canFuse(int numChannels) const;
+
+    static constexpr int fusedChunkSize = ModifierEngine::chunkSize;
+    std::array<float, fusedChunkSize> fusedLeft {}, fusedRight {}, fusedCentre {}, fusedGain {}, fusedVolume {}, fusedOscillator {};
+    void applyState(const PluginState& state);
+    void processRecall(juce::AudioBuffer<float>& buffer);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleOscAudioProcessor)
 };
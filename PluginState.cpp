@@ -0,0 +1,146 @@
+// === PluginState.cpp ===
+#include "PluginState.h"
+
+void PluginState::writeTo(juce::MemoryBlock& dest) const
+{
+    juce::MemoryOutputStream out(dest, false);
+
+    out.writeInt(magic);
+    out.writeInt(currentVersion);
+
+    out.writeCompressedInt((int) parameters.size());
+    for (const auto& [id, value] : parameters)
+    {
+        out.writeString(id);
+        out.writeFloat(value);
+    }
+
+    out.writeString(snapPack);
+    out.writeCompressedInt((int) snapFrequencies.size());
+    for (auto f : snapFrequencies)
+        out.writeFloat(f);
+
+    out.writeByte((char) modifierFlags);
+    for (auto slot : modifierOrder)
+        out.writeByte((char) slot);
+}
+
+namespace
+{
+    // Reads that fail instead of returning zeros or empty strings when the chunk runs out
+
+    bool has(const juce::MemoryInputStream& in, juce::int64 numBytes)
+    {
+        return in.getNumBytesRemaining() >= numBytes;
+    }
+
+    bool readCount(juce::MemoryInputStream& in, int& count)
+    {
+        if (! has(in, 1))
+            return false;
+
+        // readCompressedInt: a size byte, then that many value bytes
+        const auto sizeByte = static_cast<const juce::uint8*>(in.getData())[in.getPosition()];
+        const int numBytes = sizeByte & 0x7f;
+        if (numBytes > 4 || ! has(in, 1 + numBytes))
+            return false;
+
+        count = in.readCompressedInt();
+        return count >= 0;
+    }
+
+    bool readString(juce::MemoryInputStream& in, juce::String& dest)
+    {
+        // readString stops at a null terminator, so there must be one before the end
+        const auto* start = static_cast<const char*>(in.getData()) + in.getPosition();
+        if (std::memchr(start, 0, (size_t) in.getNumBytesRemaining()) == nullptr)
+            return false;
+
+        dest = in.readString();
+        return true;
+    }
+
+    bool readFloat(juce::MemoryInputStream& in, float& dest)
+    {
+        if (! has(in, 4))
+            return false;
+
+        dest = in.readFloat();
+        return true;
+    }
+}
+
+bool PluginState::readFrom(const void* data, int sizeInBytes)
+{
+    juce::MemoryInputStream in(data, (size_t) juce::jmax(0, sizeInBytes), false);
+
+    if (! has(in, 8) || in.readInt() != magic)
+        return false;
+
+    const int version = in.readInt();
+    if (version < 1 || version > currentVersion)
+        return false;
+
+    // Parsed into a copy, so a chunk that turns out to be short leaves this state untouched
+    PluginState parsed;
+
+    int numParameters = 0;
+    if (! readCount(in, numParameters) || ! has(in, (juce::int64) numParameters * 5)) // at least "" + float each
+        return false;
+
+    parsed.parameters.reserve((size_t) numParameters);
+    for (int i = 0; i < numParameters; ++i)
+    {
+        juce::String id;
+        float value = 0.0f;
+        if (! readString(in, id) || ! readFloat(in, value))
+            return false;
+        parsed.parameters.emplace_back(id, value);
+    }
+
+    int numFrequencies = 0;
+    if (! readString(in, parsed.snapPack) || ! readCount(in, numFrequencies)
+        || ! has(in, (juce::int64) numFrequencies * 4))
+        return false;
+
+    parsed.snapFrequencies.resize((size_t) numFrequencies);
+    for (auto& f : parsed.snapFrequencies)
+        f = in.readFloat();
+
+    // Version 1 chunks may end before the flags; from version 2 on, flags and order are always written
+    parsed.hasModifierFlags = has(in, 1);
+    if (version >= 2 && ! has(in, 1 + (juce::int64) parsed.modifierOrder.size()))
+        return false;
+
+    if (parsed.hasModifierFlags)
+        parsed.modifierFlags = (juce::uint8) in.readByte();
+
+    parsed.hasModifierOrder = version >= 2;
+    if (parsed.hasModifierOrder)
+        for (auto& slot : parsed.modifierOrder)
+            slot = (int) in.readByte();
+
+    *this = std::move(parsed);
+    return true;
+}
+
+bool PluginState::readLegacyTree(const juce::ValueTree& tree)
+{
+    // Anything else (another plugin's XML, a corrupt chunk) mustn't be applied as a preset of defaults
+    if (! tree.isValid() || ! tree.hasType(legacyTreeType))
+        return false;
+
+    parameters.clear();
+    for (const auto& child : tree)
+        if (child.hasType("PARAM") && child.hasProperty("id") && child.hasProperty("value"))
+            parameters.emplace_back(child.getProperty("id").toString(), (float) child.getProperty("value"));
+
+    snapPack = tree.getProperty("snapPack").toString();
+    snapFrequencies.clear();
+    for (const auto& token : juce::StringArray::fromTokens(tree.getProperty("snapFrequencies").toString(), ",", ""))
+        snapFrequencies.push_back(token.getFloatValue());
+
+    hasModifierFlags = false;
+    hasModifierOrder = false;
+    return true;
+}
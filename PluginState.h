@@ -0,0 +1,39 @@
+// === PluginState.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Everything a session restores, in a versioned binary chunk.
+ *
+ * Layout (little-endian, via juce::MemoryOutputStream):
+ *   int32  magic "SOSC", int32 version
+ *   cint   parameter count, then { string id, float value } per parameter
+ *   string selected snap pack, cint count, float frequencies[count]
+ *   uint8  modifier slot enable flags (bit n = slot n)
+ *   uint8  modifier slot order[4], first to run first (version 2)
+ *
+ * Parameter values are stored denormalised and keyed by ID, so adding or
+ * reordering parameters doesn't break older sessions.
+ */
+struct PluginState
+{
+    static constexpr int magic = 0x43534f53; // "SOSC"
+    static constexpr int currentVersion = 2;
+    static constexpr const char* legacyTreeType = "APVTS"; // the processor's APVTS state type
+
+    std::vector<std::pair<juce::String, float>> parameters;
+    juce::String snapPack;
+    std::vector<float> snapFrequencies;
+    juce::uint8 modifierFlags = 0;
+    bool hasModifierFlags = false;
+    std::array<int, 4> modifierOrder {};
+    bool hasModifierOrder = false;
+
+    void writeTo(juce::MemoryBlock& dest) const;
+
+    /** False if the data isn't a complete PluginState chunk (e.g. an older XML session, or truncated). */
+    bool readFrom(const void* data, int sizeInBytes);
+
+    /** Sessions saved before the binary format: the APVTS tree as XML. False for any other tree. */
+    bool readLegacyTree(const juce::ValueTree& tree);
+};
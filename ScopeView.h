@@ -0,0 +1,125 @@
+// === ScopeView.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "VisualizationBridge.h"
+
+/**
+ * Oscilloscope + L/R meters fed from the processor's VisualizationBridge.
+ *
+ * The top lane overlays the left and right envelopes, the bottom lane shows
+ * the mid signal where the binaural beat and the breath envelope are visible.
+ * update() is driven by the editor's timer.
+ */
+class ScopeView : public juce::Component
+{
+public:
+    static constexpr int historySize = VisualizationBridge::scopeFramesPerSecond * 4; // 4 s window
+
+    explicit ScopeView(VisualizationBridge& b) : bridge(b)
+    {
+        history.resize(historySize, ScopeFrame { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+        bridge.discardScopeAndLevels();
+        setInterceptsMouseClicks(false, false);
+    }
+
+    void update()
+    {
+        std::array<ScopeFrame, 256> incoming;
+        int n = 0;
+        while ((n = bridge.pullScopeFrames(incoming.data(), (int) incoming.size())) > 0)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                history[(size_t) writeIndex] = incoming[(size_t) i];
+                writeIndex = (writeIndex + 1) % historySize;
+            }
+        }
+
+        LevelFrame levels;
+        const bool fresh = bridge.pullLevels(levels);
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            // Fast attack, slow release
+            float newPeak = fresh ? levels.peak[ch] : 0.0f;
+            float newRms = fresh ? levels.rms[ch] : 0.0f;
+            peak[ch] = juce::jmax(newPeak, peak[ch] * 0.92f);
+            rms[ch] = juce::jmax(newRms, rms[ch] * 0.85f);
+        }
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto area = getLocalBounds().toFloat();
+        g.setColour(juce::Colours::black.withAlpha(0.3f));
+        g.fillRoundedRectangle(area, 6.0f);
+        g.setColour(juce::Colour::fromString("ff757575"));
+        g.drawRoundedRectangle(area, 6.0f, 1.0f);
+
+        area = area.reduced(6.0f);
+        auto meterArea = area.removeFromRight(22.0f);
+        area.removeFromRight(6.0f);
+
+        auto stereoLane = area.removeFromTop(area.getHeight() * 0.5f);
+        auto midLane = area;
+
+        g.setColour(juce::Colours::aqua.withAlpha(0.45f));
+        g.fillPath(makeBand(stereoLane, &ScopeFrame::minL, &ScopeFrame::maxL));
+        g.setColour(juce::Colours::orange.withAlpha(0.45f));
+        g.fillPath(makeBand(stereoLane, &ScopeFrame::minR, &ScopeFrame::maxR));
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.fillPath(makeBand(midLane, &ScopeFrame::minMid, &ScopeFrame::maxMid));
+
+        // Meters
+        auto leftMeter = meterArea.removeFromLeft(10.0f);
+        meterArea.removeFromLeft(2.0f);
+        drawMeter(g, leftMeter, 0);
+        drawMeter(g, meterArea, 1);
+    }
+
+private:
+    VisualizationBridge& bridge;
+    std::vector<ScopeFrame> history;
+    int writeIndex = 0;
+    float peak[2] = { 0.0f, 0.0f };
+    float rms[2] = { 0.0f, 0.0f };
+
+    juce::Path makeBand(juce::Rectangle<float> lane, float ScopeFrame::* lo, float ScopeFrame::* hi) const
+    {
+        juce::Path band;
+        const int columns = juce::jmax(2, (int) lane.getWidth());
+        const float halfHeight = lane.getHeight() * 0.5f;
+        const float centreY = lane.getCentreY();
+
+        auto frameAt = [this, columns](int column) -> const ScopeFrame& {
+            int age = (int) ((long long) (columns - 1 - column) * (historySize - 1) / (columns - 1));
+            return history[(size_t) ((writeIndex - 1 - age + historySize) % historySize)];
+        };
+        auto yFor = [centreY, halfHeight](float v) { return centreY - juce::jlimit(-1.0f, 1.0f, v) * halfHeight; };
+
+        band.startNewSubPath(lane.getX(), yFor(frameAt(0).*hi));
+        for (int c = 1; c < columns; ++c)
+            band.lineTo(lane.getX() + (float) c, yFor(frameAt(c).*hi));
+        for (int c = columns - 1; c >= 0; --c)
+            band.lineTo(lane.getX() + (float) c, yFor(frameAt(c).*lo));
+        band.closeSubPath();
+        return band;
+    }
+
+    void drawMeter(juce::Graphics& g, juce::Rectangle<float> bar, int ch) const
+    {
+        g.setColour(juce::Colours::darkgrey.withAlpha(0.4f));
+        g.fillRoundedRectangle(bar, 2.0f);
+
+        auto toY = [bar](float level) {
+            float db = juce::jmin(0.0f, juce::Decibels::gainToDecibels(level, -60.0f));
+            return juce::jmap(db, -60.0f, 0.0f, bar.getBottom(), bar.getY());
+        };
+
+        g.setColour(juce::Colours::aqua.withAlpha(0.8f));
+        g.fillRoundedRectangle(bar.withTop(toY(rms[ch])), 2.0f);
+
+        g.setColour(peak[ch] >= 1.0f ? juce::Colours::red : juce::Colours::white);
+        g.fillRect(bar.getX(), toY(peak[ch]) - 1.0f, bar.getWidth(), 2.0f);
+    }
+};
@@ -1,4 +1,5 @@
 #include "SnapPackManager.h"
+#include "PaintCache.h"
 
 class PluginEditor;  // forward declaration
 
@@ -20,20 +21,26 @@ struct SettingsWindow : public juce::Component
     
     struct ContentArea : public juce::Component {
         void paint(juce::Graphics& g) override {
-            juce::DropShadow shadow(juce::Colours::black.withAlpha(0.4f), 10, {6, 6});
-            shadow.drawForRectangle(g, getLocalBounds());
-            
-            juce::Colour topLeft = juce::Colour::fromString("ff6a6a6a");
-            juce::Colour bottomRight = juce::Colour::fromString("ff3f3f3f");
-            juce::ColourGradient diagGrad(
-                                          topLeft, 0, 0,
-                                          bottomRight, getWidth(), getHeight(),
-                                          false
-                                          );
-            
-            g.setGradientFill(diagGrad);
-            g.fillRoundedRectangle(getLocalBounds().toFloat(), 10.0f);
+            backgroundLayer.draw(g, getLocalBounds(), 0, [this](juce::Graphics& lg) {
+                juce::DropShadow shadow(juce::Colours::black.withAlpha(0.4f), 10, {6, 6});
+                shadow.drawForRectangle(lg, getLocalBounds());
+                
+                juce::Colour topLeft = juce::Colour::fromString("ff6a6a6a");
+                juce::Colour bottomRight = juce::Colour::fromString("ff3f3f3f");
+                juce::ColourGradient diagGrad(
+                                              topLeft, 0, 0,
+                                              bottomRight, getWidth(), getHeight(),
+                                              false
+                                              );
+                
+                lg.setGradientFill(diagGrad);
+                lg.fillRoundedRectangle(getLocalBounds().toFloat(), 10.0f);
+            });
         }
+
+        void resized() override { backgroundLayer.invalidate(); }
+
+        CachedLayer backgroundLayer;
     };
     
     ContentArea contentArea;
@@ -0,0 +1,390 @@
+// SnapLibrary.cpp
+#include "SnapLibrary.h"
+
+namespace
+{
+    constexpr int pollIntervalMs = 2000;
+    const char* const packExtension = ".snappack";
+    const char* const indexFileName = "index.json";
+}
+
+SnapLibrary::SnapLibrary() = default;
+
+SnapLibrary::~SnapLibrary()
+{
+    stopTimer();
+}
+
+const std::map<juce::String, std::vector<float>>& SnapLibrary::builtInPacks()
+{
+    static const std::map<juce::String, std::vector<float>> packs {
+        {"Deep Sleep",          {0.0f, 40.0f, 50.0f, 62.0f, 108.0f, 120.0f, 136.1f, 174.0f, 285.0f}},
+        {"Solfeggio (Default)", {0.0f, 174.0f, 285.0f, 396.0f, 417.0f, 528.0f, 639.0f, 741.0f, 852.0f, 963.0f}},
+        {"Mood Lifter",         {0.0f, 136.1f, 432.0f, 528.0f, 852.0f, 888.0f, 963.0f}},
+        {"Anxiety Buster",      {0.0f, 111.0f, 136.1f, 396.0f, 417.0f, 444.0f, 528.0f, 639.0f, 741.0f}},
+        {"Focus Mode",          {0.0f, 40.0f, 111.0f, 144.72f, 396.0f, 417.0f, 528.0f, 888.0f, 963.0f}},
+    };
+    return packs;
+}
+
+const juce::StringArray& SnapLibrary::getBuiltInNames() const
+{
+    static const juce::StringArray orderedNames {
+        "Deep Sleep",
+        "Solfeggio (Default)",
+        "Mood Lifter",
+        "Anxiety Buster",
+        "Focus Mode"
+    };
+    return orderedNames;
+}
+
+juce::File SnapLibrary::getDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("SimpleOsc")
+               .getChildFile("SnapPacks");
+}
+
+// === Queries ===
+
+juce::StringArray SnapLibrary::getAllPackNames()
+{
+    juce::StringArray names = getBuiltInNames();
+    names.addArray(getUserPackNames());
+    return names;
+}
+
+juce::StringArray SnapLibrary::getUserPackNames()
+{
+    const juce::ScopedLock sl(lock);
+    ensureIndexLoaded();
+
+    juce::StringArray names;
+    names.ensureStorageAllocated((int) userPacks.size());
+    for (const auto& entry : userPacks) // std::map keeps these sorted
+        names.add(entry.first);
+    return names;
+}
+
+bool SnapLibrary::isBuiltIn(const juce::String& name) const
+{
+    return builtInPacks().count(name) > 0;
+}
+
+bool SnapLibrary::isUserPack(const juce::String& name)
+{
+    const juce::ScopedLock sl(lock);
+    ensureIndexLoaded();
+    return userPacks.count(name) > 0;
+}
+
+std::vector<float> SnapLibrary::getPack(const juce::String& name)
+{
+    auto builtIn = builtInPacks().find(name);
+    if (builtIn != builtInPacks().end())
+        return builtIn->second;
+
+    const juce::ScopedLock sl(lock);
+    ensureIndexLoaded();
+
+    auto it = userPacks.find(name);
+    if (it == userPacks.end())
+        return {};
+
+    loadEntry(it->second);
+    return it->second.frequencies;
+}
+
+juce::String SnapLibrary::makeUniqueName(const juce::String& base)
+{
+    juce::String name = base;
+    int index = 1;
+    while (contains(name))
+        name = base + " " + juce::String(index++);
+    return name;
+}
+
+// === Edits ===
+
+void SnapLibrary::setUserPack(const juce::String& name, std::vector<float> frequencies)
+{
+    if (name.isEmpty() || isBuiltIn(name))
+        return;
+
+    {
+        const juce::ScopedLock sl(lock);
+        ensureIndexLoaded();
+
+        auto& entry = userPacks[name];
+        if (entry.file == juce::File())
+            entry.file = fileForName(name);
+        entry.frequencies = std::move(frequencies);
+        writePackFile(name, entry);
+        saveIndex();
+    }
+    sendChangeMessage();
+}
+
+juce::String SnapLibrary::addUserPack(const juce::String& baseName, std::vector<float> frequencies)
+{
+    // Held across naming and writing so concurrent imports can't pick the same name
+    const juce::ScopedLock sl(lock);
+    auto name = makeUniqueName(baseName);
+    setUserPack(name, std::move(frequencies));
+    return name;
+}
+
+bool SnapLibrary::removeUserPack(const juce::String& name)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        ensureIndexLoaded();
+
+        auto it = userPacks.find(name);
+        if (it == userPacks.end())
+            return false;
+
+        scannedFiles.erase(it->second.file.getFullPathName());
+        it->second.file.deleteFile();
+        userPacks.erase(it);
+        saveIndex();
+    }
+    sendChangeMessage();
+    return true;
+}
+
+bool SnapLibrary::renameUserPack(const juce::String& oldName, const juce::String& newName)
+{
+    if (newName.isEmpty() || newName == oldName || contains(newName))
+        return false;
+
+    {
+        const juce::ScopedLock sl(lock);
+        ensureIndexLoaded();
+
+        auto it = userPacks.find(oldName);
+        if (it == userPacks.end())
+            return false;
+
+        Entry entry = std::move(it->second);
+        userPacks.erase(it);
+        loadEntry(entry);
+
+        scannedFiles.erase(entry.file.getFullPathName());
+        entry.file.deleteFile();
+        entry.file = fileForName(newName);
+        writePackFile(newName, entry);
+        userPacks[newName] = std::move(entry);
+        saveIndex();
+    }
+    sendChangeMessage();
+    return true;
+}
+
+// === Disk ===
+
+void SnapLibrary::ensureIndexLoaded()
+{
+    if (indexLoaded)
+        return;
+    indexLoaded = true;
+
+    auto dir = getDirectory();
+    dir.createDirectory();
+
+    // Trust the index for every file whose modification time still matches
+    auto index = juce::JSON::parse(dir.getChildFile(indexFileName));
+    if (auto* packs = index["packs"].getArray())
+    {
+        for (const auto& pack : *packs)
+        {
+            const auto name = pack["name"].toString();
+            Entry entry;
+            entry.file = dir.getChildFile(pack["file"].toString());
+            entry.modified = (juce::int64) pack["modified"];
+            entry.size = (juce::int64) pack["size"];
+            entry.count = (int) pack["count"];
+            scannedFiles[entry.file.getFullPathName()] = { entry.modified, entry.size, name, entry.count };
+            userPacks[name] = std::move(entry);
+        }
+    }
+
+    if (rescanDirectory())
+        saveIndex();
+
+    startTimer(pollIntervalMs);
+}
+
+bool SnapLibrary::rescanDirectory()
+{
+    // Sorted, so when two files declare the same name the same one wins on every poll
+    auto files = getDirectory().findChildFiles(juce::File::findFiles, false, juce::String("*") + packExtension);
+    files.sort();
+
+    std::map<juce::String, ScannedFile> scanned;
+    std::map<juce::String, std::vector<float>> parsed; // frequencies read on this poll, by path
+    std::map<juce::String, juce::String> owners;       // pack name -> path of the file providing it
+
+    for (const auto& file : files)
+    {
+        const auto path = file.getFullPathName();
+        ScannedFile info { file.getLastModificationTime().toMilliseconds(), file.getSize(), {}, 0 };
+
+        // Only new files, or ones edited outside this process, get parsed
+        auto previous = scannedFiles.find(path);
+        const bool unchanged = previous != scannedFiles.end()
+                            && previous->second.modified == info.modified && previous->second.size == info.size;
+        if (unchanged)
+        {
+            info = previous->second;
+        }
+        else
+        {
+            std::vector<float> frequencies;
+            if (readPackFile(file, info.name, frequencies) && ! isBuiltIn(info.name))
+            {
+                info.count = (int) frequencies.size();
+                parsed[path] = std::move(frequencies);
+            }
+            else
+            {
+                info.name = {};
+            }
+        }
+        scanned[path] = info;
+
+        if (info.name.isEmpty())
+            continue;
+        if (owners.count(info.name) == 0)
+            owners[info.name] = path;
+        else if (! unchanged)
+            DBG("SnapLibrary: " << path << " also declares \"" << info.name << "\"; "
+                << owners[info.name] << " keeps providing it");
+    }
+    scannedFiles = std::move(scanned);
+
+    bool changed = false;
+    for (auto it = userPacks.begin(); it != userPacks.end();)
+    {
+        if (owners.count(it->first) == 0)
+        {
+            it = userPacks.erase(it);
+            changed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (const auto& [name, path] : owners)
+    {
+        const auto& info = scannedFiles[path];
+        auto existing = userPacks.find(name);
+        if (existing != userPacks.end() && existing->second.file.getFullPathName() == path
+            && existing->second.modified == info.modified && existing->second.size == info.size)
+            continue;
+
+        Entry entry;
+        entry.file = juce::File(path);
+        entry.modified = info.modified;
+        entry.size = info.size;
+        entry.count = info.count;
+        auto fresh = parsed.find(path);
+        if (fresh != parsed.end())
+        {
+            entry.loaded = true;
+            entry.frequencies = std::move(fresh->second);
+        }
+        userPacks[name] = std::move(entry);
+        changed = true;
+    }
+
+    return changed;
+}
+
+void SnapLibrary::saveIndex()
+{
+    juce::Array<juce::var> packs;
+    for (const auto& entry : userPacks)
+    {
+        auto* pack = new juce::DynamicObject();
+        pack->setProperty("name", entry.first);
+        pack->setProperty("file", entry.second.file.getFileName());
+        pack->setProperty("modified", entry.second.modified);
+        pack->setProperty("size", entry.second.size);
+        pack->setProperty("count", entry.second.count);
+        packs.add(juce::var(pack));
+    }
+
+    auto* index = new juce::DynamicObject();
+    index->setProperty("version", 1);
+    index->setProperty("packs", packs);
+
+    getDirectory().getChildFile(indexFileName).replaceWithText(juce::JSON::toString(juce::var(index)));
+}
+
+void SnapLibrary::loadEntry(Entry& entry)
+{
+    if (entry.loaded)
+        return;
+
+    juce::String ignoredName;
+    readPackFile(entry.file, ignoredName, entry.frequencies);
+    entry.count = (int) entry.frequencies.size();
+    entry.loaded = true;
+}
+
+void SnapLibrary::writePackFile(const juce::String& name, Entry& entry)
+{
+    juce::Array<juce::var> values;
+    values.ensureStorageAllocated((int) entry.frequencies.size());
+    for (auto f : entry.frequencies)
+        values.add(f);
+
+    auto* pack = new juce::DynamicObject();
+    pack->setProperty("name", name);
+    pack->setProperty("frequencies", values);
+
+    entry.file.replaceWithText(juce::JSON::toString(juce::var(pack)));
+    entry.modified = entry.file.getLastModificationTime().toMilliseconds();
+    entry.size = entry.file.getSize();
+    entry.count = (int) entry.frequencies.size();
+    entry.loaded = true;
+    scannedFiles[entry.file.getFullPathName()] = { entry.modified, entry.size, name, entry.count };
+}
+
+juce::File SnapLibrary::fileForName(const juce::String& name) const
+{
+    auto file = getDirectory().getChildFile(juce::File::createLegalFileName(name) + packExtension);
+    return file.existsAsFile() ? file.getNonexistentSibling(false) : file;
+}
+
+bool SnapLibrary::readPackFile(const juce::File& file, juce::String& name, std::vector<float>& frequencies)
+{
+    auto parsed = juce::JSON::parse(file);
+    name = parsed["name"].toString();
+
+    frequencies.clear();
+    if (auto* values = parsed["frequencies"].getArray())
+    {
+        frequencies.reserve((size_t) values->size());
+        for (const auto& v : *values)
+            frequencies.push_back((float) v);
+    }
+    return name.isNotEmpty();
+}
+
+void SnapLibrary::timerCallback()
+{
+    bool changed = false;
+    {
+        const juce::ScopedLock sl(lock);
+        changed = rescanDirectory();
+        if (changed)
+            saveIndex();
+    }
+    if (changed)
+        sendChangeMessage();
+}
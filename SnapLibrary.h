@@ -0,0 +1,91 @@
+// SnapLibrary.h
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Process-wide store of snap packs, shared by every plugin instance through
+ * juce::SharedResourcePointer<SnapLibrary>.
+ *
+ * Built-in packs are compiled in. User packs live on disk as one
+ * .snappack JSON file each, with an index.json next to them holding the
+ * name, size and modification time of every file. The index is read the
+ * first time the library is queried, and a pack's frequencies are only
+ * parsed when that pack is asked for.
+ *
+ * While the index is loaded the directory is polled for external changes;
+ * listeners get a change message when packs are added, edited or removed.
+ * A poll only parses files whose modification time or size changed. When two
+ * files declare the same name, the first in sorted path order provides it.
+ */
+class SnapLibrary : public juce::ChangeBroadcaster,
+                    private juce::Timer
+{
+public:
+    SnapLibrary();
+    ~SnapLibrary() override;
+
+    /** Built-ins in their fixed order, followed by user packs sorted by name. */
+    juce::StringArray getAllPackNames();
+    const juce::StringArray& getBuiltInNames() const;
+    juce::StringArray getUserPackNames();
+
+    bool isBuiltIn(const juce::String& name) const;
+    bool isUserPack(const juce::String& name);
+    bool contains(const juce::String& name) { return isBuiltIn(name) || isUserPack(name); }
+
+    /** Returns an empty vector if no such pack exists. */
+    std::vector<float> getPack(const juce::String& name);
+
+    /** Creates or replaces a user pack and writes it to disk. */
+    void setUserPack(const juce::String& name, std::vector<float> frequencies);
+    /** Stores a new pack under a unique name derived from `baseName` and returns that name. */
+    juce::String addUserPack(const juce::String& baseName, std::vector<float> frequencies);
+    bool removeUserPack(const juce::String& name);
+    bool renameUserPack(const juce::String& oldName, const juce::String& newName);
+
+    /** `base`, or `base N` for the first N that isn't taken. */
+    juce::String makeUniqueName(const juce::String& base);
+
+    static juce::File getDirectory();
+
+private:
+    struct Entry
+    {
+        juce::File file;
+        juce::int64 modified = 0;
+        juce::int64 size = 0;
+        int count = 0;
+        bool loaded = false;
+        std::vector<float> frequencies;
+    };
+
+    /** What the last poll saw of a .snappack file, whether or not it provides a pack. */
+    struct ScannedFile
+    {
+        juce::int64 modified = 0;
+        juce::int64 size = 0;
+        juce::String name; // as declared; empty if unreadable or a built-in name
+        int count = 0;
+    };
+
+    juce::CriticalSection lock;
+    std::map<juce::String, Entry> userPacks;
+    std::map<juce::String, ScannedFile> scannedFiles; // by full path
+    bool indexLoaded = false;
+
+    static const std::map<juce::String, std::vector<float>>& builtInPacks();
+
+    void ensureIndexLoaded();
+    bool rescanDirectory();
+    void saveIndex();
+    void loadEntry(Entry& entry);
+    void writePackFile(const juce::String& name, Entry& entry);
+    juce::File fileForName(const juce::String& name) const;
+
+    static bool readPackFile(const juce::File& file, juce::String& name, std::vector<float>& frequencies);
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnapLibrary)
+};
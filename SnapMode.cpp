@@ -0,0 +1,41 @@
+// === SnapMode.cpp ===
+#include "SnapMode.h"
+#include "PluginProcessor.h"
+
+void SnapMode::renderChunk(float* carrier, float* quadrature, int n)
+{
+    if (!targetValid || processor->getAudioSnapVersion() != snapListVersion)
+        updateTarget();
+
+    FreeMode::renderChunk(carrier, quadrature, n);
+}
+
+void SnapMode::setParameters(const EngineParameters& params)
+{
+    setGlideParameters(params);
+
+    if (params.freeFrequency != requestedFrequency)
+    {
+        // Snapped in the next renderChunk, against the audio thread's list
+        requestedFrequency = params.freeFrequency;
+        targetValid = false;
+    }
+}
+
+void SnapMode::updateTarget()
+{
+    const auto& snapList = processor->getAudioSnapFrequencies();
+    snapListVersion = processor->getAudioSnapVersion();
+    targetValid = true;
+
+    float target = requestedFrequency;
+    if (!snapList.empty())
+    {
+        target = *std::min_element(snapList.begin(), snapList.end(),
+            [this](float a, float b) {
+                return std::abs(a - requestedFrequency) < std::abs(b - requestedFrequency);
+            });
+    }
+
+    setFrequency(target);
+}
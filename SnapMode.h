@@ -0,0 +1,28 @@
+// === SnapMode.h ===
+#pragma once
+#include "FreeMode.h"
+
+/**
+ * FreeMode locked to the active snap pack. The nearest pack frequency is
+ * worked out once when the free frequency or the pack changes, and FreeMode
+ * renders that, so there's no per-sample search.
+ */
+class SnapMode : public FreeMode
+{
+public:
+    explicit SnapMode(SimpleOscAudioProcessor* proc) : FreeMode(proc) {}
+
+    void renderChunk(float* carrier, float* quadrature, int n) override;
+    void setParameters(const EngineParameters& params) override;
+
+private:
+    void updateTarget();
+
+    float requestedFrequency = 0.0f;
+
+    // The snap list version the target was computed from, and whether it's still current
+    // for the requested frequency. A freed list's address can come back for the next one,
+    // so the list is told apart by version, not by pointer.
+    juce::uint32 snapListVersion = 0;
+    bool targetValid = false;
+};
@@ -1,12 +1,18 @@
 // SnapPackManager.cpp
 #include "SnapPackManager.h"
+#include <numeric>
 
 SnapPackManager::SnapPackManager() {
     setSize(320, 480); // fits inside SettingsWindow contentArea (2:3 ratio)
     
-    addAndMakeVisible(packListViewport);
-    packListContainer = std::make_unique<juce::Component>();
-    packListViewport.setViewedComponent(packListContainer.get(), true);
+    addAndMakeVisible(searchBox);
+    searchBox.setTextToShowWhenEmpty("Filter...", juce::Colours::grey);
+    searchBox.onTextChange = [this]() { applyFilter(); };
+
+    addAndMakeVisible(packList);
+    packList.setModel(this);
+    packList.setRowHeight(32);
+    packList.setColour(juce::ListBox::backgroundColourId, juce::Colours::transparentBlack);
     
     addAndMakeVisible(frequencyDisplay);
     frequencyDisplay.setMultiLine(true);
@@ -19,21 +25,17 @@ SnapPackManager::SnapPackManager() {
     addAndMakeVisible(deletePackButton);
     addAndMakeVisible(copyPackButton);
     addAndMakeVisible(renamePackButton);
+    addAndMakeVisible(importPackButton);
     addAndMakeVisible(closeButton);
+
+    library->addChangeListener(this);
     
     // Set up button callbacks (initial)
     createPackButton.onClick = [this]() {
-        juce::String baseName = "New Snap Pack";
-        juce::String newName = baseName;
-        int index = 1;
-        
-        // Check if name exists, and increment if needed
-        while (userPacks.count(newName) > 0 || builtInPacks.count(newName) > 0) {
-            newName = baseName + " " + juce::String(index);
-            ++index;
-        }
+        // Picks "New Snap Pack", "New Snap Pack 1", ... whichever is free
+        juce::String newName = library->makeUniqueName("New Snap Pack");
         
-        userPacks[newName] = {};
+        library->setUserPack(newName, {});
         refreshPackList();
 
     // Setup Copy and Rename actions
@@ -42,9 +44,9 @@ SnapPackManager::SnapPackManager() {
         auto original = currentSelection;
         juce::String newName = original + " Copy";
         int suffix = 1;
-        while (userPacks.count(newName) > 0 || builtInPacks.count(newName) > 0)
+        while (library->contains(newName))
             newName = original + " Copy " + juce::String(suffix++);
-        userPacks[newName] = userPacks[original];
+        library->setUserPack(newName, library->getPack(original));
         refreshPackList();
         refreshFrequencyDisplay();
     };
@@ -52,7 +54,7 @@ SnapPackManager::SnapPackManager() {
     renamePackButton.onClick = [this]() {
         if (!isCustomPack(currentSelection)) return;
         renameRequestedName = currentSelection;
-        refreshPackList();
+        packList.updateContent(); // swaps just that row for an inline editor
     };
         refreshFrequencyDisplay();
     };
@@ -60,27 +62,44 @@ SnapPackManager::SnapPackManager() {
     addFrequencyButton.onClick = [this]() {
         if (!isCustomPack(currentSelection)) return;
         float val = frequencyInput.getText().getFloatValue();
-        userPacks[currentSelection].push_back(val);
-        std::sort(userPacks[currentSelection].begin(), userPacks[currentSelection].end(), std::greater<float>());
+        auto vec = library->getPack(currentSelection);
+
+        // Packs stay ascending (FreeSlider and the editor rely on it), without duplicates
+        auto pos = std::lower_bound(vec.begin(), vec.end(), val);
+        if (pos != vec.end() && *pos == val) return;
+        vec.insert(pos, val);
+        library->setUserPack(currentSelection, std::move(vec));
         refreshFrequencyDisplay();
     };
     
     removeFrequencyButton.onClick = [this]() {
         if (!isCustomPack(currentSelection)) return;
         float val = frequencyInput.getText().getFloatValue();
-        auto& vec = userPacks[currentSelection];
+        auto vec = library->getPack(currentSelection);
         vec.erase(std::remove(vec.begin(), vec.end(), val), vec.end());
+        library->setUserPack(currentSelection, std::move(vec));
         refreshFrequencyDisplay();
     };
     
     deletePackButton.onClick = [this]() {
         if (!isCustomPack(currentSelection)) return;
-        userPacks.erase(currentSelection);
+        library->removeUserPack(currentSelection);
         currentSelection = "";
         refreshPackList();
         refreshFrequencyDisplay();
     };
     
+    importPackButton.onClick = [this]() {
+        importChooser = std::make_unique<juce::FileChooser>("Import tuning files", juce::File(),
+                                                            "*.scl;*.kbm;*.csv;*.txt");
+        auto flags = juce::FileBrowserComponent::openMode
+                   | juce::FileBrowserComponent::canSelectFiles
+                   | juce::FileBrowserComponent::canSelectMultipleItems;
+        importChooser->launchAsync(flags, [this](const juce::FileChooser& chooser) {
+            importFiles(chooser.getResults());
+        });
+    };
+    
     closeButton.onClick = [this]() {
         setVisible(false);
         if (auto* parent = getParentComponent())
@@ -106,7 +125,10 @@ void SnapPackManager::resized() {
     auto left = area.removeFromLeft(180);
     left.removeFromTop(20); // spacing from top
     auto leftHeight = area.getHeight() - 20; // match frequencyInput base
-    packListViewport.setBounds(left.removeFromTop(leftHeight - 90)); // extra room for both buttons
+    searchBox.setBounds(left.removeFromTop(24));
+    left.removeFromTop(4);
+    packList.setBounds(left.removeFromTop(leftHeight - 120 - 28)); // extra room for the buttons
+    importPackButton.setBounds(left.removeFromTop(30));
     createPackButton.setBounds(left.removeFromTop(30));
     deletePackButton.setBounds(left.removeFromTop(30));
 
@@ -129,128 +151,187 @@ void SnapPackManager::resized() {
 }
 
 void SnapPackManager::refreshPackList() {
-    packListContainer->removeAllChildren();
+    // Rebuild the name index once per library change; rows themselves are
+    // painted on demand by the ListBox, so nothing is created per pack
+    packNames = library->getAllPackNames();
+
+    lowerCaseNames.clear();
+    lowerCaseNames.reserve((size_t) packNames.size());
+    for (const auto& name : packNames)
+        lowerCaseNames.push_back(name.toLowerCase());
+
+    activeFilter.clear();
+    applyFilter();
+}
+
+void SnapPackManager::applyFilter() {
+    auto filter = searchBox.getText().trim().toLowerCase();
+
+    // Typing more characters can only narrow the match set, so filter the current rows
+    bool narrowing = activeFilter.isNotEmpty() && filter.startsWith(activeFilter);
+    std::vector<int> source;
+    if (narrowing) {
+        source.swap(filteredRows);
+    } else {
+        source.resize(lowerCaseNames.size());
+        std::iota(source.begin(), source.end(), 0);
+    }
+
+    filteredRows.clear();
+    filteredRows.reserve(source.size());
+    for (int index : source)
+        if (filter.isEmpty() || lowerCaseNames[(size_t) index].contains(filter))
+            filteredRows.push_back(index);
 
-    // inline rename logic removed
+    activeFilter = filter;
+    packList.updateContent();
+    packList.repaint();
+}
+
+juce::String SnapPackManager::nameForRow(int row) const {
+    if (row < 0 || row >= (int) filteredRows.size())
+        return {};
+    return packNames[filteredRows[(size_t) row]];
+}
+
+int SnapPackManager::getNumRows() {
+    return (int) filteredRows.size();
+}
+
+void SnapPackManager::paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool) {
+    auto name = nameForRow(row);
+    if (name.isEmpty())
+        return;
 
-    auto renderOrderedBuiltIns = [this]() {
-        static juce::StringArray orderedNames {
-            "Deep Sleep",
-            "Solfeggio (Default)",
-            "Mood Lifter",
-            "Anxiety Buster",
-            "Focus Mode"
-        };
+    auto bounds = juce::Rectangle<float>(0.0f, 0.0f, (float) width, (float) height - 2.0f);
+    g.setColour(name == currentSelection ? juce::Colours::aqua.withAlpha(0.3f)
+                                         : juce::Colour::fromString("ff263238"));
+    g.fillRoundedRectangle(bounds, 4.0f);
 
-        for (const auto& name : orderedNames) {
-            if (builtInPacks.count(name) == 0) continue;
-            auto* b = new juce::TextButton(name);
+    g.setColour(juce::Colours::white);
+    g.setFont(15.0f);
+    g.drawFittedText(name, bounds.toNearestInt().reduced(4, 0), juce::Justification::centred, 1);
+}
+
+juce::Component* SnapPackManager::refreshComponentForRow(int row, bool, juce::Component* existing) {
+    // Only the row being renamed gets a real component
+    auto name = nameForRow(row);
+    if (name.isEmpty() || name != renameRequestedName) {
+        delete existing;
+        return nullptr;
+    }
+
+    auto* editor = dynamic_cast<juce::TextEditor*>(existing);
+    if (editor != nullptr && editor->getName() == name)
+        return editor;
+
+    delete existing;
+    editor = new juce::TextEditor(name);
+    editor->setText(name);
+    editor->setSelectAllWhenFocused(true);
+
+    editor->onReturnKey = [this, editor, name]() {
+        if (library->renameUserPack(name, editor->getText()))
+            currentSelection = editor->getText();
+        renameRequestedName.clear();
+        triggerAsyncUpdate(); // the editor can't be removed from inside its own callback
+    };
+
+    editor->onEscapeKey = [this]() {
+        renameRequestedName.clear();
+        triggerAsyncUpdate();
+    };
+
+    editor->onFocusLost = [this]() {
+        renameRequestedName.clear();
+        triggerAsyncUpdate();
+    };
+
+    juce::Component::SafePointer<juce::TextEditor> safeEditor(editor);
+    juce::MessageManager::callAsync([safeEditor]() {
+        if (safeEditor != nullptr)
+            safeEditor->grabKeyboardFocus();
+    });
+    return editor;
+}
+
+void SnapPackManager::listBoxItemClicked(int row, const juce::MouseEvent&) {
+    auto name = nameForRow(row);
+    if (name.isEmpty())
+        return;
 
-            b->onClick = [this, name]() {
     if (currentSelection != name) {
         currentSelection = name;
         renameRequestedName.clear();
+        packList.updateContent();
     }
+    packList.repaint();
     refreshFrequencyDisplay();
-    refreshPackList();
     if (onPackSelected)
         onPackSelected(name);
-};
+}
 
-            if (name == currentSelection)
-                b->setColour(juce::TextButton::buttonColourId, juce::Colours::aqua.withAlpha(0.3f));
-            else
-                b->setColour(juce::TextButton::buttonColourId, juce::Colour::fromString("ff263238"));
+void SnapPackManager::importFiles(const juce::Array<juce::File>& files) {
+    // A .kbm chosen alongside the scales applies to all of them
+    juce::File keyboardMap;
+    for (const auto& file : files)
+        if (file.hasFileExtension("kbm"))
+            keyboardMap = file;
 
-            packListContainer->addAndMakeVisible(b);
-        }
-    };
+    juce::Array<juce::File> sources;
+    for (const auto& file : files)
+        if (!file.hasFileExtension("kbm"))
+            sources.add(file);
 
-auto renderUserPacks = [this]() {
-    std::vector<juce::String> sortedNames;
-    for (const auto& entry : userPacks)
-        sortedNames.push_back(entry.first);
-    std::sort(sortedNames.begin(), sortedNames.end());
-
-    for (const auto& name : sortedNames) {
-        if (name == renameRequestedName) {
-            auto* editor = new juce::TextEditor();
-            editor->setText(name);
-            editor->setSelectAllWhenFocused(true);
-            editor->setBounds(0, packListContainer->getChildren().size() * 32, packListViewport.getWidth(), 30);
-
-            editor->onReturnKey = [this, editor, name]() {
-                auto newName = editor->getText();
-                if (!newName.isEmpty() && newName != name &&
-                    userPacks.count(newName) == 0 && builtInPacks.count(newName) == 0) {
-                    userPacks[newName] = userPacks[name];
-                    userPacks.erase(name);
-                    currentSelection = newName;
-                }
-                renameRequestedName.clear();
-                refreshPackList();
-                refreshFrequencyDisplay();
-            };
-
-            editor->onEscapeKey = [this]() {
-                renameRequestedName.clear();
-                refreshPackList();
-            };
-
-            editor->onFocusLost = [this]() {
-                renameRequestedName.clear();
-                refreshPackList();
-            };
-
-            packListContainer->addAndMakeVisible(editor);
-            editor->grabKeyboardFocus();
-        } else {
-            auto* b = new juce::TextButton(name);
-            b->onClick = [this, name]() {
-                if (currentSelection == name) {
-                    renameRequestedName.clear();
-                } else {
-                    currentSelection = name;
-                    renameRequestedName.clear();
-                }
-                refreshFrequencyDisplay();
-                refreshPackList();
-                if (onPackSelected)
-                    onPackSelected(name);
-            };
-
-            if (name == currentSelection)
-                b->setColour(juce::TextButton::buttonColourId, juce::Colours::aqua.withAlpha(0.3f));
-            else
-                b->setColour(juce::TextButton::buttonColourId, juce::Colour::fromString("ff263238"));
+    // Parse off the message thread; the library takes each pack in one write,
+    // so the list refreshes once per file rather than once per entry
+    importPool.addJob([this, sources, keyboardMap]() {
+        juce::StringArray failures;
+        for (const auto& file : sources) {
+            if (importsCancelled)
+                return juce::ThreadPoolJob::jobHasFinished;
 
-            packListContainer->addAndMakeVisible(b);
-        }
+            std::vector<float> frequencies;
+            auto result = TuningImporter::importFile(file, keyboardMap, frequencies);
+            if (result.wasOk())
+                library->addUserPack(file.getFileNameWithoutExtension(), std::move(frequencies));
+            else
+                failures.add(file.getFileName() + ": " + result.getErrorMessage());
         }
-};
 
-    renderOrderedBuiltIns();
-    renderUserPacks();
+        // Not tied to this component, so it's still shown if the manager has closed meanwhile
+        if (!failures.isEmpty())
+            juce::MessageManager::callAsync([failures]() {
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Tuning import failed",
+                                                       failures.joinIntoString("\n"));
+            });
+        return juce::ThreadPoolJob::jobHasFinished;
+    });
+}
 
-    int y = 0;
-    for (auto* child : packListContainer->getChildren()) {
-        child->setBounds(0, y, packListViewport.getWidth(), 30);
-        y += 32;
-    }
-    packListContainer->setSize(packListViewport.getWidth(), y);
-};
+void SnapPackManager::handleAsyncUpdate() {
+    refreshPackList();
+    refreshFrequencyDisplay();
+}
 
 void SnapPackManager::refreshFrequencyDisplay() {
     juce::String text;
-    const auto& mapRef = isCustomPack(currentSelection) ? userPacks : builtInPacks;
-
-    if (mapRef.count(currentSelection) > 0) {
-        for (auto val : mapRef.at(currentSelection))
-            text += juce::String(val) + "\n";
-    }
+    for (auto val : library->getPack(currentSelection))
+        text += juce::String(val) + "\n";
     frequencyDisplay.setText(text);
 }
 
 bool SnapPackManager::isCustomPack(const juce::String& name) const {
-    return userPacks.count(name) > 0;
+    return library->isUserPack(name);
+}
+
+void SnapPackManager::changeListenerCallback(juce::ChangeBroadcaster*) {
+    // Another instance (or something outside the plugin) changed the library
+    if (renameRequestedName.isNotEmpty())
+        return; // don't tear down the inline rename editor
+
+    if (!library->contains(currentSelection))
+        currentSelection = "";
+    refreshPackList();
+    refreshFrequencyDisplay();
 }
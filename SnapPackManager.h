@@ -2,12 +2,21 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SnapLibrary.h"
+#include "TuningImporter.h"
 
-
-class SnapPackManager : public juce::Component {
+class SnapPackManager : public juce::Component,
+                        private juce::ChangeListener,
+                        private juce::ListBoxModel,
+                        private juce::AsyncUpdater {
 public:
     SnapPackManager();
     ~SnapPackManager() override {
+        // A file being parsed finishes; the rest of the batch is skipped
+        importsCancelled = true;
+        importPool.removeAllJobs(true, 10000);
+        library->removeChangeListener(this);
+        packList.setModel(nullptr);
         onPackSelected = nullptr;
     }
 
@@ -18,41 +27,17 @@ public:
     std::function<void(const juce::String&)> onPackSelected;
 
     juce::StringArray getAllSnapPackNames() const {
-        juce::StringArray names;
-
-        static const juce::StringArray orderedBuiltIns {
-            "Deep Sleep",
-            "Solfeggio (Default)",
-            "Mood Lifter",
-            "Anxiety Buster",
-            "Focus Mode"
-        };
-
-        for (const auto& name : orderedBuiltIns)
-            if (builtInPacks.count(name))
-                names.add(name);
-
-        std::vector<juce::String> userSorted;
-        for (const auto& entry : userPacks)
-            userSorted.push_back(entry.first);
-        std::sort(userSorted.begin(), userSorted.end());
-
-        for (const auto& name : userSorted)
-            names.add(name);
-
-        return names;
+        return library->getAllPackNames();
     }
-    const std::vector<float>& getUserPack(const juce::String& name) const {
-        static std::vector<float> empty;
-        auto it = userPacks.find(name);
-        return (it != userPacks.end()) ? it->second : empty;
+    std::vector<float> getUserPack(const juce::String& name) const {
+        return library->isUserPack(name) ? library->getPack(name) : std::vector<float>();
     }
 
 
 private:
     // UI Elements
-    juce::Viewport packListViewport;
-    std::unique_ptr<juce::Component> packListContainer;
+    juce::TextEditor searchBox;
+    juce::ListBox packList { "Snap Packs" };
     juce::TextEditor frequencyDisplay;
     juce::TextEditor frequencyInput;
     juce::TextButton addFrequencyButton { "Add" };
@@ -61,6 +46,8 @@ private:
     juce::TextButton deletePackButton { "Delete Pack" };
     juce::TextButton copyPackButton { "Copy"};
     juce::TextButton renamePackButton { "Rename"};
+    juce::TextButton importPackButton { "Import Tuning..." };
+    std::unique_ptr<juce::FileChooser> importChooser;
     juce::String renameRequestedName;
 
     // Close Button
@@ -96,21 +83,37 @@ private:
     bool closeHovered = false;
     bool closeDown = false;
 
-    // Snap Pack Data
-    std::map<juce::String, std::vector<float>> userPacks;
-    std::map<juce::String, std::vector<float>> builtInPacks {
-        {"Deep Sleep",      {0.0f, 40.0f, 50.0f, 62.0f, 108.0f, 120.0f, 136.1f, 174.0f, 285.0f}},
-        {"Solfeggio (Default)", {0.0f, 174.0f, 285.0f, 396.0f, 417.0f, 528.0f, 639.0f, 741.0f, 852.0f, 963.0f}},
-        {"Mood Lifter",      {0.0f, 136.1f, 528.0f, 963.0f}},
-        {"Anxiety Buster",   {0.0f, 111.0f, 136.1f, 396.0f, 417.0f, 444.0f, 528.0f, 639.0f, 741.0f}},
-        {"Focus Mode",       {0.0f, 40.0f, 144.72f, 888.0f, 963.0f}},
-    };
+    // Snap Pack Data (shared by every instance)
+    juce::SharedResourcePointer<SnapLibrary> library;
+
+    // Tuning imports parse on this one worker, a batch per job; joined in the destructor
+    juce::ThreadPool importPool { 1 };
+    std::atomic<bool> importsCancelled { false };
 
     juce::String currentSelection;
 
+    // Name index for the virtualized list: all names, their lower-case
+    // form for filtering, and the indices that pass the current filter
+    juce::StringArray packNames;
+    std::vector<juce::String> lowerCaseNames;
+    std::vector<int> filteredRows;
+    juce::String activeFilter;
+
     void refreshPackList();
     void refreshFrequencyDisplay();
     bool isCustomPack(const juce::String& name) const;
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    void applyFilter();
+    void importFiles(const juce::Array<juce::File>& files);
+    juce::String nameForRow(int row) const;
+
+    // ListBoxModel
+    int getNumRows() override;
+    void paintListBoxItem(int row, juce::Graphics&, int width, int height, bool selected) override;
+    juce::Component* refreshComponentForRow(int row, bool selected, juce::Component* existing) override;
+    void listBoxItemClicked(int row, const juce::MouseEvent&) override;
+
+    void handleAsyncUpdate() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnapPackManager)
     
@@ -0,0 +1,73 @@
+// === SpectralHarmonics.cpp ===
+#include "SpectralHarmonics.h"
+
+void SpectralHarmonics::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    binWidth = (float) (sampleRate / fftSize);
+
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    spectrum.assign((size_t) fftSize * 2, 0.0f);
+    overlap.assign((size_t) fftSize, 0.0f);
+
+    // Spectrum of a zero-phase Hann window of fftSize points at fractional bin offsets x:
+    // 0.5 D(x) + 0.25 D(x - 1) + 0.25 D(x + 1), D being the matching Dirichlet kernel
+    auto dirichlet = [](double x) {
+        const double n = fftSize;
+        if (std::abs(x) < 1.0e-9)
+            return n;
+        const double a = juce::MathConstants<double>::pi * x;
+        return std::cos(a / n) * std::sin(a) / std::sin(a / n);
+    };
+
+    const int points = 2 * kernelHalfWidth * kernelOversampling + 1;
+    kernel.resize((size_t) points + 1); // + guard point for the interpolation
+    for (int i = 0; i < points; ++i)
+    {
+        const double x = (double) i / kernelOversampling - kernelHalfWidth;
+        kernel[(size_t) i] = (float) (0.5 * dirichlet(x) + 0.25 * dirichlet(x - 1.0) + 0.25 * dirichlet(x + 1.0));
+    }
+    kernel.back() = kernel[(size_t) points - 1];
+
+    reset();
+}
+
+void SpectralHarmonics::reset()
+{
+    std::fill(overlap.begin(), overlap.end(), 0.0f);
+    readPosition = 0;
+    hopRemaining = 0;
+}
+
+void SpectralHarmonics::addPartial(float bin, float amplitude, juce::uint32 phase)
+{
+    // A cosine of this amplitude and phase, windowed: (amplitude / 2) e^(i phase) W(k - bin) per bin k,
+    // times (-1)^k to centre the window in the frame. Taps below bin 0 fold back as conjugates.
+    const float re = 0.5f * amplitude * sineTable.cos(phase);
+    const float im = 0.5f * amplitude * sineTable.sin(phase);
+    const int nyquistBin = fftSize / 2;
+
+    const int first = (int) std::ceil(bin - (float) kernelHalfWidth);
+    const int last = (int) std::floor(bin + (float) kernelHalfWidth);
+
+    for (int k = first; k <= last; ++k)
+    {
+        const float position = ((float) k - bin + (float) kernelHalfWidth) * (float) kernelOversampling;
+        const int index = juce::jlimit(0, (int) kernel.size() - 2, (int) position);
+        const float frac = position - (float) index;
+        float w = kernel[(size_t) index] + frac * (kernel[(size_t) index + 1] - kernel[(size_t) index]);
+        if (k & 1)
+            w = -w;
+
+        if (k >= 0 && k <= nyquistBin)
+        {
+            spectrum[(size_t) (2 * k)] += re * w;
+            spectrum[(size_t) (2 * k + 1)] += im * w;
+        }
+        if (k <= 0 && -k <= nyquistBin)
+        {
+            spectrum[(size_t) (-2 * k)] += re * w;
+            spectrum[(size_t) (-2 * k + 1)] -= im * w;
+        }
+    }
+}
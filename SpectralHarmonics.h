@@ -0,0 +1,165 @@
+// === SpectralHarmonics.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "PhaseAccumulator.h"
+
+/**
+ * Large-partial-count harmonics synthesised by inverse FFT and overlap-add.
+ *
+ * Each frame, every partial adds a few bins of the window's spectrum at its
+ * frequency and phase; one inverse FFT then turns all of them into a windowed
+ * frame, and frames overlap-add into the output. The per-frame cost is one FFT
+ * plus a short kernel per partial, so going from 16 to 256 partials adds little.
+ *
+ * Partial amplitudes come from a compact spectral envelope (tilt, odd/even
+ * balance, one formant) times a front end of 8 gains, spread evenly over the
+ * partials (with 8 partials each gain is exactly its own harmonic's fader).
+ * Partials run from harmonic 2 upwards; the carrier is the fundamental.
+ *
+ * Frames are hopSize samples apart, so the envelope and base frequency are
+ * picked up at that rate, and the overlapping windows crossfade between them.
+ */
+class SpectralHarmonics
+{
+public:
+    static constexpr int minPartials = 16;
+    static constexpr int maxPartials = 256;
+    static constexpr int numFrontEndGains = 8;
+
+    /** Allocates; call from prepareToPlay, not the audio thread. */
+    void prepare(double sampleRate);
+
+    /** Drops anything still overlapping, e.g. when switching to this engine. */
+    void reset();
+
+    /** Adds n samples to dest. bandLimit(f) gives each partial's anti-alias gain (0 = skip it). */
+    template <typename BandLimit>
+    void addTo(float* dest, int n, float baseFrequency,
+               const std::array<float, numFrontEndGains>& frontEnd, BandLimit&& bandLimit)
+    {
+        while (n > 0)
+        {
+            if (hopRemaining == 0)
+            {
+                synthesiseFrame(baseFrequency, frontEnd, bandLimit);
+                hopRemaining = hopSize;
+            }
+
+            const int m = juce::jmin(n, hopRemaining);
+            for (int i = 0; i < m; ++i)
+            {
+                dest[i] += overlap[(size_t) readPosition];
+                overlap[(size_t) readPosition] = 0.0f;
+                readPosition = (readPosition + 1) & (fftSize - 1);
+            }
+
+            dest += m;
+            n -= m;
+            hopRemaining -= m;
+        }
+    }
+
+    void setNumPartials(int count) { numPartials = juce::jlimit(minPartials, maxPartials, count); }
+    void setTilt(float dbPerOctave) { tilt = dbPerOctave; }
+    void setOddEven(float balance) { oddEven = juce::jlimit(-1.0f, 1.0f, balance); }
+    void setFormantFrequency(float hz) { formantFrequency = juce::jmax(1.0f, hz); }
+    void setFormantGain(float db) { formantGain = db; }
+
+private:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;       // Hann at 75% overlap sums to 2
+    static constexpr float overlapGain = 0.5f;
+    static constexpr int kernelHalfWidth = 6;         // bins either side of a partial
+    static constexpr int kernelOversampling = 32;     // table points per bin
+    static constexpr float formantWidthOctaves = 0.5f;
+
+    template <typename BandLimit>
+    void synthesiseFrame(float baseFrequency, const std::array<float, numFrontEndGains>& frontEnd, BandLimit& bandLimit)
+    {
+        std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+
+        if (baseFrequency >= 1.0f)
+        {
+            const int count = fillAmplitudes(baseFrequency, frontEnd, bandLimit);
+            for (int p = 0; p < count; ++p)
+            {
+                const float frequency = baseFrequency * (float) (p + 2);
+                const auto increment = PhaseAccumulator::incrementFor(frequency, sampleRate);
+
+                // Phase at this frame's centre; the next centre is one hop later
+                if (amplitudes[(size_t) p] > 0.0f)
+                    addPartial(frequency / binWidth, amplitudes[(size_t) p], phases[(size_t) p].phase);
+                phases[(size_t) p].phase += increment * (juce::uint32) hopSize;
+            }
+        }
+
+        fft->performRealOnlyInverseTransform(spectrum.data());
+
+        for (int i = 0; i < fftSize; ++i)
+            overlap[(size_t) ((readPosition + i) & (fftSize - 1))] += spectrum[(size_t) i] * overlapGain;
+    }
+
+    /** Envelope times front end, normalised, for each partial below the band limit. Returns the count to render. */
+    template <typename BandLimit>
+    int fillAmplitudes(float baseFrequency, const std::array<float, numFrontEndGains>& frontEnd, BandLimit& bandLimit)
+    {
+        int count = 0;
+        float energy = 0.0f;
+
+        for (int p = 0; p < numPartials; ++p)
+        {
+            const int harmonic = p + 2;
+            const float frequency = baseFrequency * (float) harmonic;
+            const float band = bandLimit(frequency);
+            if (band <= 0.0f)
+                break; // and every partial above it
+
+            const float octavesUp = std::log2((float) harmonic / 2.0f);
+            const float formantOctaves = std::log2(frequency / formantFrequency) / formantWidthOctaves;
+            const float db = tilt * octavesUp + formantGain * std::exp(-0.5f * formantOctaves * formantOctaves);
+            const float balance = (harmonic & 1) ? juce::jmin(1.0f, 1.0f - oddEven) : juce::jmin(1.0f, 1.0f + oddEven);
+
+            const float envelope = juce::Decibels::decibelsToGain(db, -200.0f) * balance;
+            energy += envelope * envelope;
+
+            // Front end gains spread evenly across the partials, interpolated in between
+            const float x = (float) p * (float) (numFrontEndGains - 1) / (float) (numPartials - 1);
+            const int i = juce::jmin((int) x, numFrontEndGains - 2);
+            const float front = frontEnd[(size_t) i] + (x - (float) i) * (frontEnd[(size_t) i + 1] - frontEnd[(size_t) i]);
+
+            amplitudes[(size_t) p] = envelope * front * band;
+            count = p + 1;
+        }
+
+        // Keep the envelope's total no louder than the 8 flat partials it replaces
+        if (energy > 0.0f)
+        {
+            const float norm = juce::jmin(1.0f, std::sqrt((float) numFrontEndGains / energy));
+            juce::FloatVectorOperations::multiply(amplitudes.data(), norm, count);
+        }
+
+        return count;
+    }
+
+    void addPartial(float bin, float amplitude, juce::uint32 phase);
+
+    double sampleRate = 44100.0;
+    float binWidth = 44100.0f / fftSize;
+
+    int numPartials = 64;
+    float tilt = -6.0f;
+    float oddEven = 0.0f;
+    float formantFrequency = 1000.0f;
+    float formantGain = 0.0f;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> spectrum;  // 2 * fftSize: N/2 + 1 interleaved bins in, fftSize samples out
+    std::vector<float> overlap;   // fftSize ring of pending output
+    std::vector<float> kernel;    // the window's spectrum over +-kernelHalfWidth bins
+    int readPosition = 0;
+    int hopRemaining = 0;
+
+    std::array<float, maxPartials> amplitudes {};
+    std::array<PhaseAccumulator, maxPartials> phases {};
+};
@@ -0,0 +1,163 @@
+// === SpectrumAnalyser.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "VisualizationBridge.h"
+
+/**
+ * Runs windowed FFTs of the engine's mid signal on its own thread.
+ *
+ * The message thread only calls requestAnalysis() and copies the latest
+ * result; the FFT, windowing and log-frequency binning never run on it.
+ */
+class SpectrumAnalyser : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 13;              // 8192 points, ~5 Hz resolution at 44.1 kHz
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numDisplayBins = 256;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float floorDb = -100.0f;
+
+    struct Result
+    {
+        std::array<float, numDisplayBins> levelsDb;
+        float maxFrequency = 20000.0f;
+        int serial = 0;
+    };
+
+    explicit SpectrumAnalyser(VisualizationBridge& b)
+        : juce::Thread("SimpleOsc Spectrum"), bridge(b)
+    {
+        latest.levelsDb.fill(floorDb);
+        bridge.discardSpectrumSamples(); // before the thread starts, so this is still the only reader
+        startThread();
+    }
+
+    ~SpectrumAnalyser() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread(1000);
+    }
+
+    void requestAnalysis() { notify(); }
+
+    /** Copies the latest result if it's newer than `dest`. */
+    bool getLatest(Result& dest)
+    {
+        const juce::ScopedLock sl(resultLock);
+        if (latest.serial == dest.serial)
+            return false;
+        dest = latest;
+        return true;
+    }
+
+    double getLastAnalysisMs() const { return lastAnalysisMs.load(); }
+
+    /** Log-spaced display bin that contains `hz`, or -1 if it's outside the analysed range. */
+    static int displayBinForFrequency(float hz, float maxFrequency)
+    {
+        if (hz < minFrequency || hz >= maxFrequency)
+            return -1;
+        float pos = std::log(hz / minFrequency) / std::log(maxFrequency / minFrequency);
+        return juce::jlimit(0, numDisplayBins - 1, (int) (pos * numDisplayBins));
+    }
+
+private:
+    VisualizationBridge& bridge;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+
+    std::vector<float> history = std::vector<float>((size_t) fftSize, 0.0f);
+    std::vector<float> fftData = std::vector<float>((size_t) fftSize * 2, 0.0f);
+    std::vector<float> incoming = std::vector<float>((size_t) VisualizationBridge::spectrumFifoSize, 0.0f);
+    int historyWritePos = 0;
+
+    // FFT bin range for each display bin, rebuilt when the sample rate changes
+    std::array<int, numDisplayBins> binStart {}, binEnd {};
+    double binnedSampleRate = 0.0;
+    float maxFrequency = 20000.0f;
+
+    juce::CriticalSection resultLock;
+    Result latest;
+    std::atomic<double> lastAnalysisMs { 0.0 };
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait(-1);
+            if (threadShouldExit())
+                break;
+            analyse();
+        }
+    }
+
+    void analyse()
+    {
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+        int numNew = bridge.pullSpectrumSamples(incoming.data(), (int) incoming.size());
+        if (numNew == 0)
+            return;
+
+        // Keep only the newest fftSize samples in the ring
+        const float* src = incoming.data() + juce::jmax(0, numNew - fftSize);
+        for (int i = juce::jmax(0, numNew - fftSize); i < numNew; ++i)
+        {
+            history[(size_t) historyWritePos] = *src++;
+            historyWritePos = (historyWritePos + 1) % fftSize;
+        }
+
+        const double sampleRate = bridge.getSampleRate();
+        if (sampleRate != binnedSampleRate)
+            rebuildBinning(sampleRate);
+
+        // Unroll the ring oldest-first, window, transform
+        const size_t tail = (size_t) (fftSize - historyWritePos);
+        std::copy(history.begin() + historyWritePos, history.end(), fftData.begin());
+        std::copy(history.begin(), history.begin() + historyWritePos, fftData.begin() + (long) tail);
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+        window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+        // Hann has a coherent gain of 0.5, so a full-scale sine reads 0 dB
+        const float scale = 4.0f / (float) fftSize;
+
+        Result result;
+        result.maxFrequency = maxFrequency;
+        for (int b = 0; b < numDisplayBins; ++b)
+        {
+            float peak = 0.0f;
+            for (int k = binStart[(size_t) b]; k < binEnd[(size_t) b]; ++k)
+                peak = juce::jmax(peak, fftData[(size_t) k]);
+            result.levelsDb[(size_t) b] = juce::Decibels::gainToDecibels(peak * scale, floorDb);
+        }
+
+        {
+            const juce::ScopedLock sl(resultLock);
+            result.serial = latest.serial + 1;
+            latest = result;
+        }
+
+        lastAnalysisMs.store(juce::Time::getMillisecondCounterHiRes() - startMs);
+    }
+
+    void rebuildBinning(double sampleRate)
+    {
+        binnedSampleRate = sampleRate;
+        maxFrequency = juce::jmin(20000.0f, (float) sampleRate * 0.5f);
+
+        const float binHz = (float) sampleRate / (float) fftSize;
+        const float ratio = maxFrequency / minFrequency;
+        for (int b = 0; b < numDisplayBins; ++b)
+        {
+            float lowHz = minFrequency * std::pow(ratio, (float) b / numDisplayBins);
+            float highHz = minFrequency * std::pow(ratio, (float) (b + 1) / numDisplayBins);
+            int start = juce::jlimit(0, fftSize / 2, juce::roundToInt(lowHz / binHz));
+            int end = juce::jlimit(start + 1, fftSize / 2 + 1, juce::roundToInt(highHz / binHz));
+            binStart[(size_t) b] = start;
+            binEnd[(size_t) b] = end;
+        }
+    }
+};
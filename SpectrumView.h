@@ -0,0 +1,149 @@
+// === SpectrumView.h ===
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "SpectrumAnalyser.h"
+#include "CustomSliderLookAndFeel.h"
+
+/**
+ * Log-frequency spectrum of the engine output with markers for the carrier
+ * and its active harmonics.
+ *
+ * update() is driven by the editor's timer. The analysis itself runs on the
+ * SpectrumAnalyser thread; this view only asks for a new frame when the cost
+ * of the last analysis plus its own paint fits in its share of the frame
+ * budget, otherwise it skips timer ticks. It repaints itself, and only when a
+ * new frame or marker position arrived; the editor's animation leaves it out.
+ * Markers sit at the frequency the engine is rendering, not the Free slider.
+ */
+class SpectrumView : public juce::Component
+{
+public:
+    explicit SpectrumView(SimpleOscAudioProcessor& p)
+        : processor(p), analyser(p.visualBridge)
+    {
+        result.levelsDb.fill(SpectrumAnalyser::floorDb);
+        setInterceptsMouseClicks(false, false);
+    }
+
+    void update()
+    {
+        if (framesUntilRefresh > 0)
+        {
+            --framesUntilRefresh;
+            return;
+        }
+
+        bool changed = false;
+        if (analyser.getLatest(result))
+        {
+            rebuildSpectrumPath();
+            changed = true;
+        }
+
+        const float lead = processor.visualBridge.getLeadFrequency();
+        if (lead != markerFrequency)
+        {
+            markerFrequency = lead;
+            changed = true;
+        }
+
+        if (changed)
+            repaint();
+
+        analyser.requestAnalysis();
+
+        const double costMs = averagePaintMs + analyser.getLastAnalysisMs();
+        framesUntilRefresh = juce::jlimit(0, maxSkippedFrames, (int) std::ceil(costMs / budgetMs) - 1);
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+        auto area = getLocalBounds().toFloat();
+        g.setColour(juce::Colours::black.withAlpha(0.3f));
+        g.fillRoundedRectangle(area, 6.0f);
+        g.setColour(juce::Colour::fromString("ff757575"));
+        g.drawRoundedRectangle(area, 6.0f, 1.0f);
+
+        g.setColour(juce::Colours::aqua.withAlpha(0.35f));
+        g.fillPath(spectrumPath);
+        g.setColour(juce::Colours::aqua.withAlpha(0.8f));
+        g.strokePath(spectrumPath, juce::PathStrokeType(1.0f));
+
+        drawMarkers(g);
+
+        const double elapsed = juce::Time::getMillisecondCounterHiRes() - startMs;
+        averagePaintMs += 0.1 * (elapsed - averagePaintMs);
+    }
+
+    void resized() override { rebuildSpectrumPath(); }
+
+private:
+    static constexpr double budgetMs = 4.0;   // a quarter of the editor's 16 ms frame
+    static constexpr int maxSkippedFrames = 11;
+    static constexpr float topDb = 0.0f;
+
+    SimpleOscAudioProcessor& processor;
+    SpectrumAnalyser analyser;
+    SpectrumAnalyser::Result result;
+    juce::Path spectrumPath;
+    int framesUntilRefresh = 0;
+    float markerFrequency = 0.0f;
+    double averagePaintMs = 0.0;
+
+    juce::Rectangle<float> plotArea() const { return getLocalBounds().toFloat().reduced(6.0f); }
+
+    float yForDb(float db, juce::Rectangle<float> plot) const
+    {
+        return juce::jmap(juce::jlimit(SpectrumAnalyser::floorDb, topDb, db),
+                          SpectrumAnalyser::floorDb, topDb, plot.getBottom(), plot.getY());
+    }
+
+    void rebuildSpectrumPath()
+    {
+        auto plot = plotArea();
+        spectrumPath.clear();
+        if (plot.isEmpty())
+            return;
+
+        const float binWidth = plot.getWidth() / SpectrumAnalyser::numDisplayBins;
+        spectrumPath.startNewSubPath(plot.getX(), plot.getBottom());
+        for (int b = 0; b < SpectrumAnalyser::numDisplayBins; ++b)
+            spectrumPath.lineTo(plot.getX() + ((float) b + 0.5f) * binWidth, yForDb(result.levelsDb[(size_t) b], plot));
+        spectrumPath.lineTo(plot.getRight(), plot.getBottom());
+        spectrumPath.closeSubPath();
+    }
+
+    void drawMarkers(juce::Graphics& g)
+    {
+        auto plot = plotArea();
+        const float carrier = markerFrequency;
+        if (carrier < 1.0f)
+            return;
+
+        const float binWidth = plot.getWidth() / SpectrumAnalyser::numDisplayBins;
+
+        auto drawMarker = [&](float hz, juce::Colour colour) {
+            int bin = SpectrumAnalyser::displayBinForFrequency(hz, result.maxFrequency);
+            if (bin < 0)
+                return;
+            float x = plot.getX() + ((float) bin + 0.5f) * binWidth;
+            float y = yForDb(result.levelsDb[(size_t) bin], plot);
+            g.setColour(colour.withAlpha(0.35f));
+            g.drawVerticalLine(juce::roundToInt(x), plot.getY(), plot.getBottom());
+            g.setColour(colour);
+            g.fillEllipse(x - 2.5f, y - 2.5f, 5.0f, 5.0f);
+        };
+
+        drawMarker(carrier, juce::Colours::white);
+
+        for (int h = 2; h <= 9; ++h)
+        {
+            juce::String id = "harmonic" + juce::String(h);
+            if (processor.parameters.getRawParameterValue(id)->load() > 0.5f)
+                drawMarker(carrier * (float) h, getHarmonicColor(h - 2));
+        }
+    }
+};
@@ -0,0 +1,139 @@
+// === SweepMode.cpp ===
+#include "SweepMode.h"
+#include "PluginProcessor.h"
+
+void SweepMode::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+}
+
+void SweepMode::processBlock(juce::AudioBuffer<float>& buffer,
+                             juce::MidiBuffer&, bool isOn)
+{
+    if (!isOn || processor == nullptr)
+    {
+        buffer.clear();
+        return;
+    }
+
+    const int numChannels = buffer.getNumChannels();
+
+    for (int start = 0; start < buffer.getNumSamples(); start += chunkSize)
+    {
+        const int n = juce::jmin(chunkSize, buffer.getNumSamples() - start);
+        renderChunk(buffer.getWritePointer(0, start), numChannels >= 2 ? buffer.getWritePointer(1, start) : nullptr, n);
+
+        for (int ch = 2; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, start, buffer, 0, start, n);
+    }
+}
+
+void SweepMode::renderChunk(float* carrier, float* quadrature, int n)
+{
+    fillTrajectory(n);
+    for (int i = 0; i < n; ++i)
+        increments[(size_t) i] = PhaseAccumulator::incrementFor(trajectory[(size_t) i], sampleRate);
+
+    if (quadrature != nullptr)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const auto p = phase.next(increments[(size_t) i]);
+            carrier[i] = sineTable.sin(p);
+            quadrature[i] = sineTable.cos(p);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n; ++i)
+            carrier[i] = sineTable.sin(phase.next(increments[(size_t) i]));
+    }
+
+    lastFrequency = trajectory[(size_t) n - 1];
+}
+
+void SweepMode::fillTrajectory(int n)
+{
+    // Position ramp for this chunk, folded into a 0..1..0 triangle
+    const double step = 1.0 / (2.0 * juce::jmax(0.01f, sweepTime) * sampleRate);
+    const float start = (float) position;
+    const float fstep = (float) step;
+    for (int i = 0; i < n; ++i)
+    {
+        const float p = start + fstep * (float) i;
+        const float wrapped = p - std::floor(p);
+        trajectory[(size_t) i] = 1.0f - std::abs(2.0f * wrapped - 1.0f);
+    }
+
+    position += step * n;
+    position -= std::floor(position);
+
+    if (source == snapPack)
+    {
+        mapToPack(n);
+        return;
+    }
+
+    const float lo = juce::jmin(rangeMin, rangeMax);
+    const float hi = juce::jmax(rangeMin, rangeMax);
+
+    if (curve == linear)
+    {
+        juce::FloatVectorOperations::multiply(trajectory.data(), hi - lo, n);
+        juce::FloatVectorOperations::add(trajectory.data(), lo, n);
+    }
+    else
+    {
+        // Equal time per octave; the bottom is clamped because log(0) has no octave
+        const float logLo = std::log(juce::jmax(1.0f, lo));
+        const float logHi = std::log(juce::jmax(1.0f, hi));
+        juce::FloatVectorOperations::multiply(trajectory.data(), logHi - logLo, n);
+        juce::FloatVectorOperations::add(trajectory.data(), logLo, n);
+        for (int i = 0; i < n; ++i)
+            trajectory[(size_t) i] = std::exp(trajectory[(size_t) i]);
+    }
+}
+
+void SweepMode::mapToPack(int n)
+{
+    // Packs are sorted with 0 Hz ("OFF") first, so the playable entries are one contiguous run
+    const auto& list = processor->getAudioSnapFrequencies();
+    size_t first = 0;
+    while (first < list.size() && list[first] < 1.0f)
+        ++first;
+
+    const int count = (int) (list.size() - first);
+    if (count == 0)
+    {
+        juce::FloatVectorOperations::clear(trajectory.data(), n);
+        return;
+    }
+    if (count == 1)
+    {
+        juce::FloatVectorOperations::fill(trajectory.data(), list[first], n);
+        return;
+    }
+
+    // Glide between neighbouring entries, each segment taking an equal share of the pass
+    const float segments = (float) (count - 1);
+    for (int i = 0; i < n; ++i)
+    {
+        const float x = trajectory[(size_t) i] * segments;
+        const int k = juce::jlimit(0, count - 2, (int) x);
+        const float frac = x - (float) k;
+        const float a = list[first + (size_t) k];
+        const float b = list[first + (size_t) k + 1];
+
+        trajectory[(size_t) i] = curve == linear ? a + (b - a) * frac
+                                                 : a * std::pow(b / a, frac);
+    }
+}
+
+void SweepMode::setParameters(const EngineParameters& params)
+{
+    rangeMin = params.rangeMin;
+    rangeMax = params.rangeMax;
+    sweepTime = params.sweepTime;
+    curve = params.exponentialSweep ? exponential : linear;
+    source = params.sweepThroughPack ? snapPack : range;
+}
@@ -0,0 +1,57 @@
+// === SweepMode.h ===
+#pragma once
+#include "OscMode.h"
+
+class SimpleOscAudioProcessor;
+
+/**
+ * Glides up and down through the frequency range (rangeMin..rangeMax) or
+ * through the active snap pack, one pass every sweepTime seconds.
+ *
+ * The frequency trajectory is generated a chunk at a time as flat arrays
+ * (position ramp -> triangle -> curve -> phase increment) so the per-sample
+ * work is straight-line vector code; only the phase accumulation and the
+ * sine table lookup are serial. Everything lives in fixed-size members, nothing allocates.
+ */
+class SweepMode : public OscMode
+{
+public:
+    enum Curve { linear, exponential };
+    enum Source { range, snapPack };
+
+    explicit SweepMode(SimpleOscAudioProcessor* proc) : processor(proc) {}
+
+    void prepare(double sampleRate) override;
+    void processBlock(juce::AudioBuffer<float>& buffer,
+                      juce::MidiBuffer& midiMessages,
+                      bool isOn) override;
+    void setParameters(const EngineParameters& params) override;
+
+    juce::uint32 getPhase() const override { return phase.phase; }
+    void setPhase(juce::uint32 newPhase) override { phase.phase = newPhase; }
+    float getFrequency() const override { return lastFrequency; }
+
+    bool canRenderChunks() const override { return true; }
+    void renderChunk(float* carrier, float* quadrature, int n) override;
+
+private:
+    static constexpr int chunkSize = 256;
+
+    void fillTrajectory(int numSamples);
+    void mapToPack(int numSamples);
+
+    SimpleOscAudioProcessor* processor = nullptr;
+    double sampleRate = 44100.0;
+
+    double position = 0.0;       // 0..1 over one up-and-down cycle
+    PhaseAccumulator phase;
+    float lastFrequency = 0.0f;
+
+    float rangeMin = 0.0f, rangeMax = 2222.0f;
+    float sweepTime = 30.0f;
+    Curve curve = exponential;
+    Source source = range;
+
+    std::array<float, chunkSize> trajectory {}; // position, then frequency in Hz
+    std::array<juce::uint32, chunkSize> increments {};
+};
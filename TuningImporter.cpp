@@ -0,0 +1,283 @@
+// TuningImporter.cpp
+#include "TuningImporter.h"
+
+namespace
+{
+    /** Next line that isn't blank or a Scala comment ("!"), trimmed. False at end of stream. */
+    bool readContentLine(juce::InputStream& in, juce::String& line)
+    {
+        while (! in.isExhausted())
+        {
+            line = in.readNextLine().trim();
+            if (line.isNotEmpty() && ! line.startsWithChar('!'))
+                return true;
+        }
+        return false;
+    }
+
+    int floorDiv(int a, int b)
+    {
+        int q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+}
+
+juce::Result TuningImporter::importFile(const juce::File& file, const juce::File& keyboardMap, std::vector<float>& result)
+{
+    if (file.hasFileExtension("scl"))
+        return importScala(file, keyboardMap, result);
+    if (file.hasFileExtension("kbm"))
+        return juce::Result::fail("A keyboard map needs a .scl scale to go with it");
+    return importFrequencyList(file, result);
+}
+
+// === Scala ===
+
+double TuningImporter::Scale::degreeRatio(int degree) const
+{
+    const int n = (int) ratios.size();
+    const int periods = floorDiv(degree, n);
+    const int step = degree - periods * n;
+    return std::pow(ratios.back(), (double) periods) * (step == 0 ? 1.0 : ratios[(size_t) step - 1]);
+}
+
+juce::Result TuningImporter::importScala(const juce::File& scaleFile, const juce::File& keyboardMapFile, std::vector<float>& result)
+{
+    Scale scale;
+    auto status = parseScale(scaleFile, scale);
+    if (status.failed())
+        return status;
+
+    result.clear();
+
+    if (keyboardMapFile == juce::File())
+    {
+        // No map: every degree, repeated by the period across the whole range. A period barely
+        // above 1/1 would take millions of repeats, so the count is checked before anything's built.
+        const double period = scale.ratios.back();
+        const int n = (int) scale.ratios.size();
+        const double lowestPeriod = std::floor(std::log(minFrequency / defaultBaseFrequency) / std::log(period));
+        const double highestPeriod = std::ceil(std::log(maxFrequency / defaultBaseFrequency) / std::log(period));
+        if ((highestPeriod - lowestPeriod + 1.0) * n > maxEntries)
+            return juce::Result::fail(scaleFile.getFileName() + " would repeat into more than "
+                                      + juce::String(maxEntries) + " frequencies; its period is too small");
+
+        const int lowest = (int) lowestPeriod;
+        const int highest = (int) highestPeriod;
+        result.reserve((size_t) (highest - lowest + 1) * (size_t) n);
+        for (int p = lowest; p <= highest; ++p)
+        {
+            const double periodBase = defaultBaseFrequency * std::pow(period, (double) p);
+            result.push_back((float) periodBase);
+            for (int d = 0; d < n - 1; ++d)
+                result.push_back((float) (periodBase * scale.ratios[(size_t) d]));
+        }
+    }
+    else
+    {
+        KeyboardMap map;
+        status = parseKeyboardMap(keyboardMapFile, map);
+        if (status.failed())
+            return status;
+
+        double referenceRatio = 1.0;
+        if (! ratioForNote(scale, map, map.referenceNote, referenceRatio))
+            return juce::Result::fail("The keyboard map's reference note is unmapped");
+
+        if ((double) map.lastNote - map.firstNote + 1.0 > maxEntries)
+            return juce::Result::fail(keyboardMapFile.getFileName() + " maps more than "
+                                      + juce::String(maxEntries) + " notes");
+
+        const double base = map.referenceFrequency / referenceRatio;
+        result.reserve((size_t) juce::jmax(0, map.lastNote - map.firstNote + 1));
+        for (int note = map.firstNote; note <= map.lastNote; ++note)
+        {
+            double ratio = 1.0;
+            if (ratioForNote(scale, map, note, ratio))
+                result.push_back((float) (base * ratio));
+        }
+    }
+
+    finalise(result);
+    return juce::Result::ok();
+}
+
+juce::Result TuningImporter::parseScale(const juce::File& file, Scale& scale)
+{
+    juce::FileInputStream in(file);
+    if (! in.openedOk())
+        return juce::Result::fail("Couldn't open " + file.getFileName());
+
+    juce::String line;
+
+    // The description may legitimately be empty, so it's the first non-comment line as-is
+    while (! in.isExhausted())
+    {
+        line = in.readNextLine();
+        if (! line.trimStart().startsWithChar('!'))
+            break;
+    }
+
+    if (! readContentLine(in, line))
+        return juce::Result::fail("Missing note count in " + file.getFileName());
+
+    const int count = line.getIntValue();
+    if (count <= 0)
+        return juce::Result::fail("A scale needs at least one note");
+
+    scale.ratios.reserve((size_t) count);
+    while ((int) scale.ratios.size() < count && readContentLine(in, line))
+    {
+        double ratio = 0.0;
+        if (! parsePitch(line, ratio))
+            return juce::Result::fail("Bad pitch \"" + line + "\" in " + file.getFileName());
+        scale.ratios.push_back(ratio);
+    }
+
+    if ((int) scale.ratios.size() != count)
+        return juce::Result::fail(file.getFileName() + " has fewer pitches than it declares");
+    if (scale.ratios.back() <= 1.0)
+        return juce::Result::fail("The scale's period must be above 1/1");
+
+    return juce::Result::ok();
+}
+
+bool TuningImporter::parsePitch(const juce::String& line, double& ratio)
+{
+    // Anything after the first whitespace is a comment
+    auto token = line.upToFirstOccurrenceOf(" ", false, false)
+                     .upToFirstOccurrenceOf("\t", false, false);
+
+    if (token.containsChar('.'))
+    {
+        ratio = std::pow(2.0, token.getDoubleValue() / 1200.0); // cents
+    }
+    else if (token.containsChar('/'))
+    {
+        const double num = token.upToFirstOccurrenceOf("/", false, false).getDoubleValue();
+        const double den = token.fromFirstOccurrenceOf("/", false, false).getDoubleValue();
+        if (den <= 0.0)
+            return false;
+        ratio = num / den;
+    }
+    else
+    {
+        ratio = token.getDoubleValue(); // bare integer = n/1
+    }
+
+    return ratio > 0.0;
+}
+
+juce::Result TuningImporter::parseKeyboardMap(const juce::File& file, KeyboardMap& map)
+{
+    juce::FileInputStream in(file);
+    if (! in.openedOk())
+        return juce::Result::fail("Couldn't open " + file.getFileName());
+
+    juce::String line;
+    std::array<juce::String, 7> header;
+    for (auto& field : header)
+    {
+        if (! readContentLine(in, line))
+            return juce::Result::fail(file.getFileName() + " is missing header fields");
+        field = line;
+    }
+
+    map.size = header[0].getIntValue();
+    map.firstNote = header[1].getIntValue();
+    map.lastNote = header[2].getIntValue();
+    map.middleNote = header[3].getIntValue();
+    map.referenceNote = header[4].getIntValue();
+    map.referenceFrequency = header[5].getDoubleValue();
+    map.octaveDegree = header[6].getIntValue();
+
+    if (map.size < 0 || map.referenceFrequency <= 0.0)
+        return juce::Result::fail(file.getFileName() + " has an invalid header");
+
+    map.mapping.assign((size_t) map.size, -1);
+    for (int i = 0; i < map.size && readContentLine(in, line); ++i)
+        map.mapping[(size_t) i] = line.startsWithIgnoreCase("x") ? -1 : line.getIntValue();
+
+    return juce::Result::ok();
+}
+
+bool TuningImporter::ratioForNote(const Scale& scale, const KeyboardMap& map, int note, double& ratio)
+{
+    const int n = (int) scale.ratios.size();
+    const int offset = note - map.middleNote;
+
+    if (map.size == 0)
+    {
+        ratio = scale.degreeRatio(offset);
+        return true;
+    }
+
+    const int repeats = floorDiv(offset, map.size);
+    const int degree = map.mapping[(size_t) (offset - repeats * map.size)];
+    if (degree < 0)
+        return false;
+
+    const int octaveDegree = map.octaveDegree > 0 ? map.octaveDegree : n;
+    ratio = std::pow(scale.degreeRatio(octaveDegree), (double) repeats) * scale.degreeRatio(degree);
+    return true;
+}
+
+// === Plain frequency lists ===
+
+juce::Result TuningImporter::importFrequencyList(const juce::File& file, std::vector<float>& result)
+{
+    juce::FileInputStream in(file);
+    if (! in.openedOk())
+        return juce::Result::fail("Couldn't open " + file.getFileName());
+
+    result.clear();
+    if (in.getTotalLength() > 0)
+        result.reserve((size_t) juce::jmin<juce::int64>(in.getTotalLength() / 4, maxEntries));
+
+    juce::StringArray tokens;
+    while (! in.isExhausted())
+    {
+        auto line = in.readNextLine().trim();
+        if (line.isEmpty() || line.startsWithChar('#') || line.startsWithChar('!'))
+            continue;
+
+        tokens.clearQuick();
+        tokens.addTokens(line, ",; \t", "\"");
+        for (auto& token : tokens)
+        {
+            token = token.trim().unquoted();
+            // Skips header cells like "Frequency (Hz)"
+            if (token.isEmpty() || ! token.containsOnly("0123456789.eE+-"))
+                continue;
+
+            float value = token.getFloatValue();
+            if (value >= minFrequency && value <= maxFrequency)
+            {
+                if ((int) result.size() == maxEntries)
+                    return juce::Result::fail(file.getFileName() + " has more than "
+                                              + juce::String(maxEntries) + " frequencies");
+                result.push_back(value);
+            }
+        }
+    }
+
+    if (result.empty())
+        return juce::Result::fail("No frequencies found in " + file.getFileName());
+
+    finalise(result);
+    return juce::Result::ok();
+}
+
+void TuningImporter::finalise(std::vector<float>& frequencies)
+{
+    frequencies.erase(std::remove_if(frequencies.begin(), frequencies.end(),
+                                     [](float f) { return f < minFrequency || f > maxFrequency; }),
+                      frequencies.end());
+
+    std::sort(frequencies.begin(), frequencies.end());
+    frequencies.erase(std::unique(frequencies.begin(), frequencies.end(),
+                                  [](float a, float b) { return std::abs(a - b) < 0.001f; }),
+                      frequencies.end());
+
+    frequencies.insert(frequencies.begin(), 0.0f);
+}
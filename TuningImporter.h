@@ -0,0 +1,52 @@
+// TuningImporter.h
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Builds snap-pack frequency lists from tuning files.
+ *
+ * Supports Scala scales (.scl) with an optional keyboard map (.kbm), and
+ * plain frequency lists (.csv / .txt, values separated by commas,
+ * semicolons, tabs, spaces or newlines). Files are streamed line by line and
+ * the result is sorted ascending and de-duplicated once at the end, with
+ * 0 Hz ("OFF") first like the built-in packs.
+ */
+struct TuningImporter
+{
+    static constexpr double defaultBaseFrequency = 261.6255653; // middle C, when there's no .kbm
+    static constexpr float minFrequency = 1.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr int maxEntries = 1 << 20;  // files that would produce more are rejected
+
+    /** Picks the parser from the file extension. `keyboardMap` may be File() for .scl files. */
+    static juce::Result importFile(const juce::File& file, const juce::File& keyboardMap, std::vector<float>& result);
+
+    static juce::Result importScala(const juce::File& scale, const juce::File& keyboardMap, std::vector<float>& result);
+    static juce::Result importFrequencyList(const juce::File& file, std::vector<float>& result);
+
+private:
+    struct Scale
+    {
+        std::vector<double> ratios; // degrees 1..N, the last one is the period
+        double degreeRatio(int degree) const;
+    };
+
+    struct KeyboardMap
+    {
+        int size = 0;               // 0 = linear mapping
+        int firstNote = 0;
+        int lastNote = 127;
+        int middleNote = 60;
+        int referenceNote = 69;
+        double referenceFrequency = 440.0;
+        int octaveDegree = 0;
+        std::vector<int> mapping;   // -1 for unmapped keys ("x")
+    };
+
+    static juce::Result parseScale(const juce::File& file, Scale& scale);
+    static juce::Result parseKeyboardMap(const juce::File& file, KeyboardMap& map);
+    static bool parsePitch(const juce::String& line, double& ratio);
+    static bool ratioForNote(const Scale& scale, const KeyboardMap& map, int note, double& ratio);
+    static void finalise(std::vector<float>& frequencies);
+};
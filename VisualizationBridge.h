@@ -0,0 +1,218 @@
+// === VisualizationBridge.h ===
+#pragma once
+#include <JuceHeader.h>
+
+/** One decimated scope column: the min/max of each channel (and of mid) over a bucket of samples. */
+struct ScopeFrame
+{
+    float minL, maxL;
+    float minR, maxR;
+    float minMid, maxMid;
+};
+
+/** Per-block peak and RMS for the left and right outputs. */
+struct LevelFrame
+{
+    float peak[2];
+    float rms[2];
+};
+
+/**
+ * Hands the engine output from the audio thread to the editor.
+ *
+ * Every stream goes through juce::AbstractFifo, so push() is wait-free and
+ * never allocates: if the editor is closed or falls behind, new data is
+ * simply dropped. All buffers are sized in prepare().
+ *
+ * Streams: decimated scope columns, per-block levels, and the full-rate mid
+ * signal for the spectrum analyser. The lead frequency, for the analyser's
+ * markers, is a single atomic value.
+ */
+class VisualizationBridge
+{
+public:
+    static constexpr int scopeFramesPerSecond = 200;
+    static constexpr int spectrumFifoSize = 1 << 15;
+
+    void prepare(double sampleRate, int samplesPerBlock)
+    {
+        currentSampleRate.store(sampleRate);
+        samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / scopeFramesPerSecond));
+        midScratch.setSize(1, juce::jmax(1, samplesPerBlock));
+        startNewFrame();
+    }
+
+    // === Audio thread ===
+    /** The frequency the lead mode is playing, 0 while the oscillator is off; once per block. */
+    void setLeadFrequency(float hz) { leadFrequency.store(hz); }
+
+    void push(const juce::AudioBuffer<float>& buffer)
+    {
+        const int numChannels = buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+        if (numChannels == 0 || numSamples == 0 || midScratch.getNumSamples() == 0)
+            return;
+
+        const float* left = buffer.getReadPointer(0);
+        const float* right = buffer.getReadPointer(juce::jmin(1, numChannels - 1));
+
+        // Levels for the whole block
+        LevelFrame levels;
+        const float* channels[2] = { left, right };
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax(channels[ch], numSamples);
+            levels.peak[ch] = juce::jmax(-range.getStart(), range.getEnd());
+            levels.rms[ch] = std::sqrt(sumOfSquares(channels[ch], numSamples) / (float) numSamples);
+        }
+        writeOne(levelFifo, levelFrames, levels);
+
+        // Scope buckets, in scratch-sized chunks in case the host exceeds the prepared block size
+        float* mid = midScratch.getWritePointer(0);
+        for (int pos = 0; pos < numSamples;)
+        {
+            const int chunk = juce::jmin(numSamples - pos, midScratch.getNumSamples());
+            juce::FloatVectorOperations::add(mid, left + pos, right + pos, chunk);
+            juce::FloatVectorOperations::multiply(mid, 0.5f, chunk);
+            writeSpectrumSamples(mid, chunk);
+
+            for (int offset = 0; offset < chunk;)
+            {
+                const int n = juce::jmin(chunk - offset, samplesPerFrame - samplesInFrame);
+                accumulate(current.minL, current.maxL, left + pos + offset, n);
+                accumulate(current.minR, current.maxR, right + pos + offset, n);
+                accumulate(current.minMid, current.maxMid, mid + offset, n);
+
+                samplesInFrame += n;
+                offset += n;
+
+                if (samplesInFrame >= samplesPerFrame)
+                {
+                    writeOne(scopeFifo, scopeFrames, current);
+                    startNewFrame();
+                }
+            }
+            pos += chunk;
+        }
+    }
+
+    // === Message thread ===
+    int pullScopeFrames(ScopeFrame* dest, int maxFrames)
+    {
+        int start1, size1, start2, size2;
+        scopeFifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+        std::copy_n(scopeFrames.begin() + start1, size1, dest);
+        std::copy_n(scopeFrames.begin() + start2, size2, dest + size1);
+        scopeFifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    int pullSpectrumSamples(float* dest, int maxSamples)
+    {
+        int start1, size1, start2, size2;
+        spectrumFifo.prepareToRead(maxSamples, start1, size1, start2, size2);
+        std::copy_n(spectrumSamples.begin() + start1, size1, dest);
+        std::copy_n(spectrumSamples.begin() + start2, size2, dest + size1);
+        spectrumFifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    double getSampleRate() const { return currentSampleRate.load(); }
+    float getLeadFrequency() const { return leadFrequency.load(); }
+
+    /**
+     * Reader side: drops whatever queued up while nobody was reading, so a view that
+     * attaches (an editor opening again) starts from live data rather than stale frames.
+     */
+    void discardScopeAndLevels()
+    {
+        scopeFifo.finishedRead(scopeFifo.getNumReady());
+        levelFifo.finishedRead(levelFifo.getNumReady());
+    }
+
+    void discardSpectrumSamples() { spectrumFifo.finishedRead(spectrumFifo.getNumReady()); }
+
+    /** Merges every pending block: the highest peak and the most recent RMS. */
+    bool pullLevels(LevelFrame& result)
+    {
+        int start1, size1, start2, size2;
+        levelFifo.prepareToRead(levelFifo.getNumReady(), start1, size1, start2, size2);
+        const int total = size1 + size2;
+
+        result = { { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+        for (int i = 0; i < total; ++i)
+        {
+            const auto& frame = levelFrames[(size_t) (i < size1 ? start1 + i : start2 + i - size1)];
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                result.peak[ch] = juce::jmax(result.peak[ch], frame.peak[ch]);
+                result.rms[ch] = frame.rms[ch];
+            }
+        }
+        levelFifo.finishedRead(total);
+        return total > 0;
+    }
+
+private:
+    static constexpr int scopeFifoSize = 2048;
+    static constexpr int levelFifoSize = 256;
+
+    juce::AbstractFifo scopeFifo { scopeFifoSize };
+    juce::AbstractFifo levelFifo { levelFifoSize };
+    std::array<ScopeFrame, scopeFifoSize> scopeFrames {};
+    std::array<LevelFrame, levelFifoSize> levelFrames {};
+    juce::AbstractFifo spectrumFifo { spectrumFifoSize };
+    std::array<float, spectrumFifoSize> spectrumSamples {};
+    std::atomic<double> currentSampleRate { 44100.0 };
+    std::atomic<float> leadFrequency { 0.0f };
+
+    juce::AudioBuffer<float> midScratch;
+    int samplesPerFrame = 220;
+    int samplesInFrame = 0;
+    ScopeFrame current {};
+
+    template <typename T, size_t N>
+    static void writeOne(juce::AbstractFifo& fifo, std::array<T, N>& storage, const T& item)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 > 0)
+            storage[(size_t) start1] = item;
+        fifo.finishedWrite(size1);
+    }
+
+    void writeSpectrumSamples(const float* data, int n)
+    {
+        int start1, size1, start2, size2;
+        spectrumFifo.prepareToWrite(n, start1, size1, start2, size2);
+        std::copy_n(data, size1, spectrumSamples.begin() + start1);
+        std::copy_n(data + size1, size2, spectrumSamples.begin() + start2);
+        spectrumFifo.finishedWrite(size1 + size2);
+    }
+
+    static void accumulate(float& lo, float& hi, const float* data, int n)
+    {
+        auto range = juce::FloatVectorOperations::findMinAndMax(data, n);
+        lo = juce::jmin(lo, range.getStart());
+        hi = juce::jmax(hi, range.getEnd());
+    }
+
+    // Four independent accumulators so the compiler can keep this in vector registers
+    static float sumOfSquares(const float* data, int n)
+    {
+        float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+            for (int k = 0; k < 4; ++k)
+                acc[k] += data[i + k] * data[i + k];
+        for (; i < n; ++i)
+            acc[0] += data[i] * data[i];
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    void startNewFrame()
+    {
+        samplesInFrame = 0;
+        current = { 1.0e9f, -1.0e9f, 1.0e9f, -1.0e9f, 1.0e9f, -1.0e9f };
+    }
+};